@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../lib/libbabydb.a"
+  "../lib/libbabydb.pdb"
+  "CMakeFiles/babydb.dir/babydb.cpp.o"
+  "CMakeFiles/babydb.dir/babydb.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/babydb.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
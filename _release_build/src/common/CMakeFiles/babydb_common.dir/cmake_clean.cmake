@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/babydb_common.dir/thread_pool.cpp.o"
+  "CMakeFiles/babydb_common.dir/thread_pool.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/babydb_common.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,32 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/concurrency/active_txn_registry.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/active_txn_registry.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/active_txn_registry.cpp.o.d"
+  "/root/repo/src/concurrency/admission_controller.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/admission_controller.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/admission_controller.cpp.o.d"
+  "/root/repo/src/concurrency/concurrency_control.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/concurrency_control.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/concurrency_control.cpp.o.d"
+  "/root/repo/src/concurrency/contention_manager.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/contention_manager.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/contention_manager.cpp.o.d"
+  "/root/repo/src/concurrency/epoch_manager.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/epoch_manager.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/epoch_manager.cpp.o.d"
+  "/root/repo/src/concurrency/garbage_collector.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/garbage_collector.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/garbage_collector.cpp.o.d"
+  "/root/repo/src/concurrency/lock_manager.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/lock_manager.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/lock_manager.cpp.o.d"
+  "/root/repo/src/concurrency/mvcc_control.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/mvcc_control.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/mvcc_control.cpp.o.d"
+  "/root/repo/src/concurrency/occ_control.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/occ_control.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/occ_control.cpp.o.d"
+  "/root/repo/src/concurrency/ssi.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/ssi.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/ssi.cpp.o.d"
+  "/root/repo/src/concurrency/transaction.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/transaction.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/transaction.cpp.o.d"
+  "/root/repo/src/concurrency/transaction_manager.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/transaction_manager.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/transaction_manager.cpp.o.d"
+  "/root/repo/src/concurrency/version_link.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/version_link.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/version_link.cpp.o.d"
+  "/root/repo/src/concurrency/write_set.cpp" "src/concurrency/CMakeFiles/babydb_concurrency.dir/write_set.cpp.o" "gcc" "src/concurrency/CMakeFiles/babydb_concurrency.dir/write_set.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,35 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/babydb_concurrency.dir/active_txn_registry.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/active_txn_registry.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/admission_controller.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/admission_controller.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/concurrency_control.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/concurrency_control.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/contention_manager.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/contention_manager.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/epoch_manager.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/epoch_manager.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/garbage_collector.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/garbage_collector.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/lock_manager.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/lock_manager.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/mvcc_control.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/mvcc_control.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/occ_control.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/occ_control.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/ssi.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/ssi.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/transaction.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/transaction.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/transaction_manager.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/transaction_manager.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/version_link.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/version_link.cpp.o.d"
+  "CMakeFiles/babydb_concurrency.dir/write_set.cpp.o"
+  "CMakeFiles/babydb_concurrency.dir/write_set.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/babydb_concurrency.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
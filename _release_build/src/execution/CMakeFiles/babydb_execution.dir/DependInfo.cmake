@@ -0,0 +1,43 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/execution/aggregate_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/aggregate_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/aggregate_operator.cpp.o.d"
+  "/root/repo/src/execution/aggregate_table.cpp" "src/execution/CMakeFiles/babydb_execution.dir/aggregate_table.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/aggregate_table.cpp.o.d"
+  "/root/repo/src/execution/bloom_filter.cpp" "src/execution/CMakeFiles/babydb_execution.dir/bloom_filter.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/bloom_filter.cpp.o.d"
+  "/root/repo/src/execution/data_chunk.cpp" "src/execution/CMakeFiles/babydb_execution.dir/data_chunk.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/data_chunk.cpp.o.d"
+  "/root/repo/src/execution/delete_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/delete_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/delete_operator.cpp.o.d"
+  "/root/repo/src/execution/execution_common.cpp" "src/execution/CMakeFiles/babydb_execution.dir/execution_common.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/execution_common.cpp.o.d"
+  "/root/repo/src/execution/expression/expression.cpp" "src/execution/CMakeFiles/babydb_execution.dir/expression/expression.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/expression/expression.cpp.o.d"
+  "/root/repo/src/execution/expression/filter.cpp" "src/execution/CMakeFiles/babydb_execution.dir/expression/filter.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/expression/filter.cpp.o.d"
+  "/root/repo/src/execution/expression/predicate_kernels.cpp" "src/execution/CMakeFiles/babydb_execution.dir/expression/predicate_kernels.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/expression/predicate_kernels.cpp.o.d"
+  "/root/repo/src/execution/expression/projection.cpp" "src/execution/CMakeFiles/babydb_execution.dir/expression/projection.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/expression/projection.cpp.o.d"
+  "/root/repo/src/execution/filter_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/filter_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/filter_operator.cpp.o.d"
+  "/root/repo/src/execution/hash_join_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/hash_join_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/hash_join_operator.cpp.o.d"
+  "/root/repo/src/execution/increment_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/increment_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/increment_operator.cpp.o.d"
+  "/root/repo/src/execution/insert_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/insert_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/insert_operator.cpp.o.d"
+  "/root/repo/src/execution/join_hash_table.cpp" "src/execution/CMakeFiles/babydb_execution.dir/join_hash_table.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/join_hash_table.cpp.o.d"
+  "/root/repo/src/execution/merge_join_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/merge_join_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/merge_join_operator.cpp.o.d"
+  "/root/repo/src/execution/pipeline.cpp" "src/execution/CMakeFiles/babydb_execution.dir/pipeline.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/pipeline.cpp.o.d"
+  "/root/repo/src/execution/projection_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/projection_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/projection_operator.cpp.o.d"
+  "/root/repo/src/execution/range_index_scan_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/range_index_scan_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/range_index_scan_operator.cpp.o.d"
+  "/root/repo/src/execution/seq_scan_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/seq_scan_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/seq_scan_operator.cpp.o.d"
+  "/root/repo/src/execution/sort_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/sort_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/sort_operator.cpp.o.d"
+  "/root/repo/src/execution/spill_file.cpp" "src/execution/CMakeFiles/babydb_execution.dir/spill_file.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/spill_file.cpp.o.d"
+  "/root/repo/src/execution/topk_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/topk_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/topk_operator.cpp.o.d"
+  "/root/repo/src/execution/update_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/update_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/update_operator.cpp.o.d"
+  "/root/repo/src/execution/value_operator.cpp" "src/execution/CMakeFiles/babydb_execution.dir/value_operator.cpp.o" "gcc" "src/execution/CMakeFiles/babydb_execution.dir/value_operator.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,57 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/babydb_execution.dir/aggregate_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/aggregate_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/aggregate_table.cpp.o"
+  "CMakeFiles/babydb_execution.dir/aggregate_table.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/bloom_filter.cpp.o"
+  "CMakeFiles/babydb_execution.dir/bloom_filter.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/data_chunk.cpp.o"
+  "CMakeFiles/babydb_execution.dir/data_chunk.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/delete_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/delete_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/execution_common.cpp.o"
+  "CMakeFiles/babydb_execution.dir/execution_common.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/expression/expression.cpp.o"
+  "CMakeFiles/babydb_execution.dir/expression/expression.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/expression/filter.cpp.o"
+  "CMakeFiles/babydb_execution.dir/expression/filter.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/expression/predicate_kernels.cpp.o"
+  "CMakeFiles/babydb_execution.dir/expression/predicate_kernels.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/expression/projection.cpp.o"
+  "CMakeFiles/babydb_execution.dir/expression/projection.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/filter_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/filter_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/hash_join_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/hash_join_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/increment_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/increment_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/insert_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/insert_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/join_hash_table.cpp.o"
+  "CMakeFiles/babydb_execution.dir/join_hash_table.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/merge_join_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/merge_join_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/pipeline.cpp.o"
+  "CMakeFiles/babydb_execution.dir/pipeline.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/projection_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/projection_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/range_index_scan_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/range_index_scan_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/seq_scan_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/seq_scan_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/sort_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/sort_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/spill_file.cpp.o"
+  "CMakeFiles/babydb_execution.dir/spill_file.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/topk_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/topk_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/update_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/update_operator.cpp.o.d"
+  "CMakeFiles/babydb_execution.dir/value_operator.cpp.o"
+  "CMakeFiles/babydb_execution.dir/value_operator.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/babydb_execution.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/storage/art.cpp" "src/storage/CMakeFiles/babydb_storage.dir/art.cpp.o" "gcc" "src/storage/CMakeFiles/babydb_storage.dir/art.cpp.o.d"
+  "/root/repo/src/storage/catalog.cpp" "src/storage/CMakeFiles/babydb_storage.dir/catalog.cpp.o" "gcc" "src/storage/CMakeFiles/babydb_storage.dir/catalog.cpp.o.d"
+  "/root/repo/src/storage/index.cpp" "src/storage/CMakeFiles/babydb_storage.dir/index.cpp.o" "gcc" "src/storage/CMakeFiles/babydb_storage.dir/index.cpp.o.d"
+  "/root/repo/src/storage/stlmap_index.cpp" "src/storage/CMakeFiles/babydb_storage.dir/stlmap_index.cpp.o" "gcc" "src/storage/CMakeFiles/babydb_storage.dir/stlmap_index.cpp.o.d"
+  "/root/repo/src/storage/table.cpp" "src/storage/CMakeFiles/babydb_storage.dir/table.cpp.o" "gcc" "src/storage/CMakeFiles/babydb_storage.dir/table.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/babydb_storage.dir/art.cpp.o"
+  "CMakeFiles/babydb_storage.dir/art.cpp.o.d"
+  "CMakeFiles/babydb_storage.dir/catalog.cpp.o"
+  "CMakeFiles/babydb_storage.dir/catalog.cpp.o.d"
+  "CMakeFiles/babydb_storage.dir/index.cpp.o"
+  "CMakeFiles/babydb_storage.dir/index.cpp.o.d"
+  "CMakeFiles/babydb_storage.dir/stlmap_index.cpp.o"
+  "CMakeFiles/babydb_storage.dir/stlmap_index.cpp.o.d"
+  "CMakeFiles/babydb_storage.dir/table.cpp.o"
+  "CMakeFiles/babydb_storage.dir/table.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/babydb_storage.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
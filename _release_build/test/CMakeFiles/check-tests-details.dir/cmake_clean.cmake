@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/check-tests-details"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/check-tests-details.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/concurrency/concurrency_test.cpp" "test/CMakeFiles/concurrency_test.dir/concurrency/concurrency_test.cpp.o" "gcc" "test/CMakeFiles/concurrency_test.dir/concurrency/concurrency_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_release_build/src/CMakeFiles/babydb.dir/DependInfo.cmake"
+  "/root/repo/_release_build/third_party/googletest/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  "/root/repo/_release_build/third_party/googletest/googlemock/CMakeFiles/gmock_main.dir/DependInfo.cmake"
+  "/root/repo/_release_build/third_party/googletest/googlemock/CMakeFiles/gmock.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
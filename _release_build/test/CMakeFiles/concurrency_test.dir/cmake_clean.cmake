@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/concurrency_test.dir/concurrency/concurrency_test.cpp.o"
+  "CMakeFiles/concurrency_test.dir/concurrency/concurrency_test.cpp.o.d"
+  "concurrency_test"
+  "concurrency_test.pdb"
+  "concurrency_test[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/concurrency_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
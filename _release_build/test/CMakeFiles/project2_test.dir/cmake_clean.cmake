@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/project2_test.dir/project2/project2_test.cpp.o"
+  "CMakeFiles/project2_test.dir/project2/project2_test.cpp.o.d"
+  "project2_test"
+  "project2_test.pdb"
+  "project2_test[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/project2_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/storage_test.dir/storage/storage_test.cpp.o"
+  "CMakeFiles/storage_test.dir/storage/storage_test.cpp.o.d"
+  "storage_test"
+  "storage_test.pdb"
+  "storage_test[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/storage_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_release_build/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_release_build/test/concurrency_test[1]_include.cmake")
+include("/root/repo/_release_build/test/execution_test[1]_include.cmake")
+include("/root/repo/_release_build/test/project2_test[1]_include.cmake")
+include("/root/repo/_release_build/test/storage_test[1]_include.cmake")
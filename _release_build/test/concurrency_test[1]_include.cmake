@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_release_build/test/concurrency_test[1]_tests.cmake")
+  include("/root/repo/_release_build/test/concurrency_test[1]_tests.cmake")
+else()
+  add_test(concurrency_test_NOT_BUILT concurrency_test_NOT_BUILT)
+endif()
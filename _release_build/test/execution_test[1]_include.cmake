@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_release_build/test/execution_test[1]_tests.cmake")
+  include("/root/repo/_release_build/test/execution_test[1]_tests.cmake")
+else()
+  add_test(execution_test_NOT_BUILT execution_test_NOT_BUILT)
+endif()
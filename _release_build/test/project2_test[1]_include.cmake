@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_release_build/test/project2_test[1]_tests.cmake")
+  include("/root/repo/_release_build/test/project2_test[1]_tests.cmake")
+else()
+  add_test(project2_test_NOT_BUILT project2_test_NOT_BUILT)
+endif()
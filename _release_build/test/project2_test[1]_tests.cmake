@@ -0,0 +1,17 @@
+add_test([=[Project2Test.DirtyRead]=]  /root/repo/_release_build/test/project2_test [==[--gtest_filter=Project2Test.DirtyRead]==] --gtest_also_run_disabled_tests [==[--gtest_output=xml:/root/repo/_release_build/test/project2_test.xml]==] [==[--gtest_catch_exceptions=0]==])
+set_tests_properties([=[Project2Test.DirtyRead]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_release_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==] TIMEOUT 120)
+add_test([=[Project2Test.NonRepeatableRead]=]  /root/repo/_release_build/test/project2_test [==[--gtest_filter=Project2Test.NonRepeatableRead]==] --gtest_also_run_disabled_tests [==[--gtest_output=xml:/root/repo/_release_build/test/project2_test.xml]==] [==[--gtest_catch_exceptions=0]==])
+set_tests_properties([=[Project2Test.NonRepeatableRead]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_release_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==] TIMEOUT 120)
+add_test([=[Project2Test.TaintedTest]=]  /root/repo/_release_build/test/project2_test [==[--gtest_filter=Project2Test.TaintedTest]==] --gtest_also_run_disabled_tests [==[--gtest_output=xml:/root/repo/_release_build/test/project2_test.xml]==] [==[--gtest_catch_exceptions=0]==])
+set_tests_properties([=[Project2Test.TaintedTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_release_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==] TIMEOUT 120)
+add_test([=[Project2Test.AbortTest]=]  /root/repo/_release_build/test/project2_test [==[--gtest_filter=Project2Test.AbortTest]==] --gtest_also_run_disabled_tests [==[--gtest_output=xml:/root/repo/_release_build/test/project2_test.xml]==] [==[--gtest_catch_exceptions=0]==])
+set_tests_properties([=[Project2Test.AbortTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_release_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==] TIMEOUT 120)
+add_test([=[Project2Test.SerializableTest]=]  /root/repo/_release_build/test/project2_test [==[--gtest_filter=Project2Test.SerializableTest]==] --gtest_also_run_disabled_tests [==[--gtest_output=xml:/root/repo/_release_build/test/project2_test.xml]==] [==[--gtest_catch_exceptions=0]==])
+set_tests_properties([=[Project2Test.SerializableTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_release_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==] TIMEOUT 120)
+add_test([=[Project2Test.BankSystemTest]=]  /root/repo/_release_build/test/project2_test [==[--gtest_filter=Project2Test.BankSystemTest]==] --gtest_also_run_disabled_tests [==[--gtest_output=xml:/root/repo/_release_build/test/project2_test.xml]==] [==[--gtest_catch_exceptions=0]==])
+set_tests_properties([=[Project2Test.BankSystemTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_release_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==] TIMEOUT 120)
+add_test([=[Project2Test.SellSystemTest]=]  /root/repo/_release_build/test/project2_test [==[--gtest_filter=Project2Test.SellSystemTest]==] --gtest_also_run_disabled_tests [==[--gtest_output=xml:/root/repo/_release_build/test/project2_test.xml]==] [==[--gtest_catch_exceptions=0]==])
+set_tests_properties([=[Project2Test.SellSystemTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_release_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==] TIMEOUT 120)
+add_test([=[Project2Test.GCTest]=]  /root/repo/_release_build/test/project2_test [==[--gtest_filter=Project2Test.GCTest]==] --gtest_also_run_disabled_tests [==[--gtest_output=xml:/root/repo/_release_build/test/project2_test.xml]==] [==[--gtest_catch_exceptions=0]==])
+set_tests_properties([=[Project2Test.GCTest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_release_build/test SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==] TIMEOUT 120)
+set(  project2_test_TESTS Project2Test.DirtyRead Project2Test.NonRepeatableRead Project2Test.TaintedTest Project2Test.AbortTest Project2Test.SerializableTest Project2Test.BankSystemTest Project2Test.SellSystemTest Project2Test.GCTest)
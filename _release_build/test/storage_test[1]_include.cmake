@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_release_build/test/storage_test[1]_tests.cmake")
+  include("/root/repo/_release_build/test/storage_test[1]_tests.cmake")
+else()
+  add_test(storage_test_NOT_BUILT storage_test_NOT_BUILT)
+endif()
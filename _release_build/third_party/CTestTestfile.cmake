@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/third_party
+# Build directory: /root/repo/_release_build/third_party
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("googletest")
@@ -1,59 +1,192 @@
 #include "babydb.hpp"
 
+#include "common/thread_pool.hpp"
 #include "common/typedefs.hpp"
 #include "storage/catalog.hpp"
 #include "storage/index.hpp"
 #include "storage/stlmap_index.hpp"
 #include "storage/art.hpp"
 #include "storage/table.hpp"
+#include "concurrency/garbage_collector.hpp"
 #include "concurrency/transaction_manager.hpp"
+#include "concurrency/version_link.hpp"
+
+#include <thread>
 
 namespace babydb {
 
-BabyDB::BabyDB(const ConfigGroup &config) : catalog_(std::make_unique<Catalog>()),
-    txn_mgr_(std::make_unique<TransactionManager>(config.ISOLATION_LEVEL)), config_(std::make_unique<ConfigGroup>(config)) {}
+static idx_t WorkerThreadCount(const ConfigGroup &config) {
+    if (config.WORKER_THREADS != 0) {
+        return config.WORKER_THREADS;
+    }
+    idx_t hardware_threads = std::thread::hardware_concurrency();
+    // The thread waiting for a parallel task also executes it.
+    return hardware_threads > 1 ? hardware_threads - 1 : 0;
+}
+
+BabyDB::BabyDB(const ConfigGroup &config) : txn_mgr_(std::make_unique<TransactionManager>(config)),
+    config_(std::make_unique<ConfigGroup>(config)), thread_pool_(std::make_unique<ThreadPool>(WorkerThreadCount(config))) {
+    Publish(std::make_shared<Catalog>());
+}
 
 BabyDB::~BabyDB() {
-    catalog_.reset();
+    // The indexes are retired to the garbage collector, which frees them when it stops.
+    Publish(nullptr);
     txn_mgr_.reset();
+    thread_pool_.reset();
+}
+
+BabyDB::CatalogShard& BabyDB::LocalCatalogShard() const {
+    // Threads are spread over the shards round-robin on their first transaction.
+    thread_local idx_t local_shard_id = next_catalog_shard_.fetch_add(1);
+    return catalog_shards_[local_shard_id % CATALOG_SHARD_COUNT];
+}
+
+std::shared_ptr<const Catalog> BabyDB::GetCatalog() const {
+    auto &shard = LocalCatalogShard();
+    std::unique_lock lock(shard.latch);
+    return shard.catalog;
+}
+
+void BabyDB::Publish(std::shared_ptr<const Catalog> catalog) {
+    for (auto &shard : catalog_shards_) {
+        std::unique_lock lock(shard.latch);
+        shard.catalog = catalog;
+    }
 }
 
 void BabyDB::CreateTable(const std::string &table_name, const Schema &schema) {
-    std::unique_lock lock(db_lock_);
-    catalog_->CreateTable(std::make_unique<Table>(table_name, schema));
+    std::unique_lock lock(ddl_latch_);
+    auto catalog = GetCatalog()->Clone();
+    catalog->CreateTable(std::make_shared<Table>(table_name, schema));
+    Publish(std::move(catalog));
 }
 
 void BabyDB::DropTable(const std::string &table_name) {
-    std::unique_lock lock(db_lock_);
-    catalog_->DropTable(table_name);
+    std::unique_lock lock(ddl_latch_);
+    if (indexing_tables_.count(table_name) != 0) {
+        throw std::logic_error("DROP TABLE: an index of the table is being built");
+    }
+    auto catalog = GetCatalog()->Clone();
+    catalog->DropTable(table_name);
+    Publish(std::move(catalog));
+    // A table created with the same name is a new one.
+    dropped_indexes_.erase(table_name);
 }
 
 void BabyDB::CreateIndex(const std::string &index_name, const std::string &table_name, const std::string &key_column,
                          IndexType index_type) {
-    std::unique_lock lock(db_lock_);
-    auto &table = catalog_->FetchTable(table_name);
+    // The build and the wait for the writers of the dropped index run without the latch, other DDL goes on meanwhile.
+    std::shared_ptr<const Catalog> current;
+    std::shared_ptr<Index> dropped;
+    idx_t first_row;
+    {
+        std::unique_lock lock(ddl_latch_);
+        current = GetCatalog();
+        auto &table = current->FetchTable(table_name);
+        if (current->GetTableIndex(table_name) != INVALID_NAME || indexing_tables_.count(table_name) != 0) {
+            throw std::logic_error("CREATE INDEX: table already has an index");
+        }
+        indexing_tables_.insert(table_name);
+        auto read_guard = table.GetReadTableGuard();
+        first_row = read_guard.Rows().size();
+        auto dropped_position = dropped_indexes_.find(table_name);
+        if (dropped_position != dropped_indexes_.end()) {
+            dropped = dropped_position->second.lock();
+            dropped_indexes_.erase(dropped_position);
+        }
+    }
 
-    switch (index_type) {
-    case Stlmap:
-        catalog_->CreateIndex(std::make_unique<StlmapIndex>(index_name, table, key_column));
-        break;
+    std::unique_ptr<Index> index;
+    try {
+        auto &table = current->FetchTable(table_name);
+        // Transactions go on meanwhile, the ones of the current version can't write a table without an index.
+        switch (index_type) {
+        case Stlmap:
+            index = std::make_unique<StlmapIndex>(index_name, table, key_column);
+            break;
 
-    case ART:
-        catalog_->CreateIndex(std::make_unique<ArtIndex>(index_name, table, key_column));
-        break;
+        case ART:
+            index = std::make_unique<ArtIndex>(index_name, table, key_column, *thread_pool_);
+            break;
 
-    default:
-        throw std::logic_error("CREATE INDEX: unknown index type");
+        default:
+            throw std::logic_error("CREATE INDEX: unknown index type");
+        }
+        // The writers through the dropped index still append rows. Once they are finished, the rows they
+        // committed during the build are indexed from the table.
+        if (dropped) {
+            dropped->WaitForWriters();
+            dropped.reset();
+        }
+        index->CatchUp(table, first_row);
+        // The writers are finished, every row in the table is visible from the current ts on.
+        auto read_guard = table.GetReadTableGuard();
+        if (!read_guard.Rows().empty()) {
+            index->build_ts_ = txn_mgr_->GetVisibleTs();
+        }
+    } catch (...) {
+        std::unique_lock lock(ddl_latch_);
+        indexing_tables_.erase(table_name);
+        throw;
     }
+
+    // The last catalog version holding the index may be released by a commit, the garbage collector frees
+    // the index and its lists in its own pass.
+    std::shared_ptr<Index> shared_index(index.release(),
+                                        [retired = txn_mgr_->GetGarbageCollector().GetRetireList()](Index *index) {
+        retired->Retire([index](VersionSkipList *row_list) { return index->LookupVersions(row_list->key) == row_list; },
+                        [index] { delete index; });
+    });
+    std::unique_lock lock(ddl_latch_);
+    indexing_tables_.erase(table_name);
+    auto catalog = GetCatalog()->Clone();
+    catalog->CreateIndex(std::move(shared_index));
+    Publish(std::move(catalog));
 }
 
 void BabyDB::DropIndex(const std::string &index_name) {
-    std::unique_lock lock(db_lock_);
-    catalog_->DropIndex(index_name);
+    std::unique_lock lock(ddl_latch_);
+    auto current = GetCatalog();
+    auto index = current->GetIndexPtr(index_name);
+    auto catalog = current->Clone();
+    catalog->DropIndex(index_name);
+    // The transactions that wrote through it before go on, the others can't write the table anymore.
+    index->RefuseWriters();
+    Publish(std::move(catalog));
+    dropped_indexes_[index->table_name_] = index;
+}
+
+void BabyDB::SetRowLocking(const std::string &table_name, bool row_locking) {
+    GetCatalog()->FetchTable(table_name).SetRowLocking(row_locking);
+}
+
+std::shared_ptr<Transaction> BabyDB::CreateTxn(bool row_locking) {
+    return txn_mgr_->CreateTxn(GetCatalog(), row_locking);
+}
+
+std::shared_ptr<Transaction> BabyDB::RestartTxn(const Transaction &aborted) {
+    return txn_mgr_->CreateTxn(GetCatalog(), aborted.RowLocking(), aborted.priority_);
+}
+
+std::shared_ptr<Transaction> BabyDB::CreateTxnAsOf(idx_t commit_ts) {
+    return txn_mgr_->CreateTxnAsOf(commit_ts, GetCatalog());
+}
+
+std::shared_ptr<Transaction> BabyDB::CreateTxnAsOf(const std::string &snapshot_name) {
+    return CreateTxnAsOf(txn_mgr_->GetSnapshotTs(snapshot_name));
+}
+
+idx_t BabyDB::CreateSnapshot(const std::string &snapshot_name) {
+    return txn_mgr_->CreateSnapshot(snapshot_name);
+}
+
+void BabyDB::DropSnapshot(const std::string &snapshot_name) {
+    txn_mgr_->DropSnapshot(snapshot_name);
 }
 
-std::shared_ptr<Transaction> BabyDB::CreateTxn() {
-    return txn_mgr_->CreateTxn(std::shared_lock(db_lock_));
+idx_t BabyDB::GetAdmissionLimit() {
+    return txn_mgr_->GetAdmissionLimit();
 }
 
 bool BabyDB::Commit(Transaction &txn) {
@@ -0,0 +1,144 @@
+#include "common/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace babydb {
+
+//! The pool and the index of the worker running on this thread.
+static thread_local ThreadPool *current_pool = nullptr;
+static thread_local idx_t current_worker = INVALID_ID;
+
+ThreadPool::ThreadPool(idx_t thread_count) {
+    for (idx_t i = 0; i < thread_count; i++) {
+        queues_.push_back(std::make_unique<JobQueue>());
+    }
+    for (idx_t i = 0; i < thread_count; i++) {
+        workers_.emplace_back([this, i] { WorkerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock lock(latch_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Schedule(std::function<void()> &&job) {
+    auto queue_id = current_pool == this ? current_worker : next_queue_.fetch_add(1) % queues_.size();
+    {
+        std::unique_lock lock(queues_[queue_id]->latch);
+        queues_[queue_id]->jobs.push_back(std::move(job));
+    }
+    {
+        std::unique_lock lock(latch_);
+        pending_jobs_++;
+    }
+    cv_.notify_one();
+}
+
+std::function<void()> ThreadPool::TakeJob(idx_t worker_id) {
+    std::function<void()> job;
+    for (idx_t i = 0; i < queues_.size() && !job; i++) {
+        auto &queue = *queues_[(worker_id + i) % queues_.size()];
+        std::unique_lock lock(queue.latch);
+        if (queue.jobs.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        } else {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+    }
+    return job;
+}
+
+void ThreadPool::WorkerLoop(idx_t worker_id) {
+    current_pool = this;
+    current_worker = worker_id;
+    while (true) {
+        {
+            std::unique_lock lock(latch_);
+            cv_.wait(lock, [this] { return stop_ || pending_jobs_ > 0; });
+            if (pending_jobs_ == 0) {
+                return;
+            }
+            // A job is counted after it is pushed, so a claimed one is always found in some deque.
+            pending_jobs_--;
+        }
+        TakeJob(worker_id)();
+    }
+}
+
+namespace {
+
+//! Shared by the caller and the helpers of one ParallelFor. Helpers may start after the caller returned,
+//! so it lives on the heap and they only touch `body` after successfully claiming a task.
+struct ParallelForState {
+    std::function<void(idx_t)> body;
+    idx_t task_count;
+    std::atomic<idx_t> next_task{0};
+    std::atomic<idx_t> finished_tasks{0};
+    std::exception_ptr error;
+    std::mutex latch;
+    std::condition_variable cv;
+
+    void RunTasks() {
+        idx_t task_id;
+        while ((task_id = next_task.fetch_add(1)) < task_count) {
+            try {
+                body(task_id);
+            } catch (...) {
+                std::unique_lock lock(latch);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            if (finished_tasks.fetch_add(1) + 1 == task_count) {
+                std::unique_lock lock(latch);
+                cv.notify_all();
+            }
+        }
+    }
+};
+
+}
+
+void ThreadPool::ParallelFor(idx_t task_count, const std::function<void(idx_t)> &body) {
+    if (task_count == 0) {
+        return;
+    }
+    if (task_count == 1 || workers_.empty()) {
+        for (idx_t task_id = 0; task_id < task_count; task_id++) {
+            body(task_id);
+        }
+        return;
+    }
+    auto state = std::make_shared<ParallelForState>();
+    state->body = body;
+    state->task_count = task_count;
+    auto helper_count = std::min<idx_t>(task_count - 1, workers_.size());
+    for (idx_t i = 0; i < helper_count; i++) {
+        Schedule([state] { state->RunTasks(); });
+    }
+    state->RunTasks();
+    {
+        std::unique_lock lock(state->latch);
+        state->cv.wait(lock, [&state] { return state->finished_tasks.load() == state->task_count; });
+    }
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+}
@@ -0,0 +1,67 @@
+#include "concurrency/active_txn_registry.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace babydb {
+
+void ActiveTxnRegistry::Shard::Lock() {
+    while (latch.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+ActiveTxnRegistry::Shard& ActiveTxnRegistry::LocalShard(idx_t &shard_id) {
+    // Threads are spread over the shards round-robin on their first transaction.
+    thread_local idx_t local_shard_id = next_shard_.fetch_add(1) % SHARD_COUNT;
+    shard_id = local_shard_id;
+    return shards_[shard_id];
+}
+
+std::pair<idx_t, idx_t> ActiveTxnRegistry::Register(const std::atomic<idx_t> &last_commit_ts) {
+    idx_t shard_id;
+    auto &shard = LocalShard(shard_id);
+    shard.Lock();
+    // Announce a lower bound first, then take the read ts. A watermark computed before the announcement
+    // became visible read last_commit_ts earlier, so it's not above the read ts.
+    auto announced = last_commit_ts.load();
+    if (announced < shard.min_read_ts.load()) {
+        shard.min_read_ts.store(announced);
+    }
+    auto read_ts = last_commit_ts.load();
+    shard.read_ts_count[read_ts]++;
+    shard.PublishMin();
+    shard.Unlock();
+    return std::make_pair(read_ts, shard_id);
+}
+
+idx_t ActiveTxnRegistry::RegisterAt(idx_t read_ts) {
+    idx_t shard_id;
+    auto &shard = LocalShard(shard_id);
+    shard.Lock();
+    shard.read_ts_count[read_ts]++;
+    shard.PublishMin();
+    shard.Unlock();
+    return shard_id;
+}
+
+void ActiveTxnRegistry::Unregister(idx_t shard_id, idx_t read_ts) {
+    auto &shard = shards_[shard_id];
+    shard.Lock();
+    auto iter = shard.read_ts_count.find(read_ts);
+    if (iter != shard.read_ts_count.end() && --iter->second == 0) {
+        shard.read_ts_count.erase(iter);
+        shard.PublishMin();
+    }
+    shard.Unlock();
+}
+
+idx_t ActiveTxnRegistry::Watermark(const std::atomic<idx_t> &last_commit_ts) const {
+    auto watermark = last_commit_ts.load();
+    for (auto &shard : shards_) {
+        watermark = std::min(watermark, shard.min_read_ts.load());
+    }
+    return watermark;
+}
+
+}
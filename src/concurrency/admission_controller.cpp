@@ -0,0 +1,39 @@
+#include "concurrency/admission_controller.hpp"
+
+#include <algorithm>
+
+namespace babydb {
+
+AdmissionController::AdmissionController(idx_t max_limit)
+    : max_limit_(max_limit), limit_(static_cast<double>(max_limit)) {}
+
+void AdmissionController::Acquire(bool wait) {
+    std::unique_lock lock(latch_);
+    if (wait) {
+        cv_.wait(lock, [this] { return static_cast<double>(running_) + 1 <= limit_; });
+    }
+    running_++;
+}
+
+void AdmissionController::Release(bool committed) {
+    {
+        std::unique_lock lock(latch_);
+        running_--;
+        finished_since_decrease_++;
+        if (committed) {
+            limit_ = std::min(static_cast<double>(max_limit_), limit_ + 1 / limit_);
+        } else if (static_cast<double>(finished_since_decrease_) >= limit_) {
+            // The aborts of one overloaded period halve it only once.
+            limit_ = std::max(MIN_LIMIT, limit_ / 2);
+            finished_since_decrease_ = 0;
+        }
+    }
+    cv_.notify_one();
+}
+
+idx_t AdmissionController::GetLimit() {
+    std::unique_lock lock(latch_);
+    return Enabled() ? static_cast<idx_t>(limit_) : 0;
+}
+
+}
@@ -0,0 +1,22 @@
+#include "concurrency/concurrency_control.hpp"
+#include "concurrency/mvcc_control.hpp"
+#include "concurrency/occ_control.hpp"
+
+#include <stdexcept>
+
+namespace babydb {
+
+std::unique_ptr<ConcurrencyControl> ConcurrencyControl::Create(const ConfigGroup &config, const GarbageCollector &gc) {
+    switch (config.CONCURRENCY_CONTROL) {
+    case ConcurrencyControlType::MVCC:
+        return std::make_unique<MvccControl>(config.ISOLATION_LEVEL, gc);
+
+    case ConcurrencyControlType::OCC:
+        return std::make_unique<OccControl>();
+
+    default:
+        throw std::logic_error("Unknown concurrency control.");
+    }
+}
+
+}
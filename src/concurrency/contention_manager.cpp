@@ -0,0 +1,108 @@
+#include "concurrency/contention_manager.hpp"
+#include "concurrency/transaction.hpp"
+#include "concurrency/version_link.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace babydb {
+
+ContentionManager::ContentionManager(ContentionPolicy policy, idx_t max_wait_us)
+    : policy_(policy), max_wait_(max_wait_us) {}
+
+ContentionManager::Stripe& ContentionManager::StripeOf(VersionSkipList *row_list) {
+    return stripes_[std::hash<VersionSkipList*>()(row_list) % STRIPE_COUNT];
+}
+
+ContentionManager::PriorityShard& ContentionManager::ShardOf(idx_t txn_id) {
+    return priority_shards_[txn_id % PRIORITY_SHARD_COUNT];
+}
+
+void ContentionManager::Register(const Transaction &txn) {
+    if (txn.priority_ == txn.txn_id_) {
+        return;
+    }
+    auto &shard = ShardOf(txn.txn_id_);
+    std::unique_lock lock(shard.latch);
+    shard.priorities.emplace(txn.txn_id_, txn.priority_);
+    restarted_txns_.fetch_add(1);
+}
+
+void ContentionManager::Unregister(const Transaction &txn) {
+    if (txn.priority_ == txn.txn_id_) {
+        return;
+    }
+    auto &shard = ShardOf(txn.txn_id_);
+    std::unique_lock lock(shard.latch);
+    shard.priorities.erase(txn.txn_id_);
+    restarted_txns_.fetch_sub(1);
+}
+
+idx_t ContentionManager::PriorityOf(idx_t txn_id) {
+    if (restarted_txns_.load() == 0) {
+        return txn_id;
+    }
+    auto &shard = ShardOf(txn_id);
+    std::unique_lock lock(shard.latch);
+    auto iter = shard.priorities.find(txn_id);
+    return iter == shard.priorities.end() ? txn_id : iter->second;
+}
+
+static bool Released(VersionSkipList *row_list, idx_t txn_id) {
+    Datalist* holder = row_list->uncommitted;
+    return !holder || holder->txn_id == txn_id;
+}
+
+bool ContentionManager::WaitRelease(VersionSkipList *row_list, idx_t txn_id,
+                                    std::chrono::steady_clock::time_point deadline) {
+    if (Released(row_list, txn_id)) {
+        return true;
+    }
+    auto &stripe = StripeOf(row_list);
+    std::unique_lock lock(stripe.latch);
+    stripe.waiters.fetch_add(1);
+    auto released = stripe.cv.wait_until(lock, deadline, [row_list, txn_id] { return Released(row_list, txn_id); });
+    stripe.waiters.fetch_sub(1);
+    return released;
+}
+
+void ContentionManager::BeforeWrite(const Transaction &txn, VersionSkipList *row_list) {
+    if (policy_ != ContentionPolicy::WAIT_DIE) {
+        return;
+    }
+    Datalist* holder = row_list->uncommitted;
+    // Smaller priorities are older. A younger writer goes on and dies at the claim.
+    if (holder && holder->txn_id != txn.txn_id_ && PriorityOf(holder->txn_id) > txn.priority_) {
+        WaitRelease(row_list, txn.txn_id_, std::chrono::steady_clock::now() + max_wait_);
+    }
+}
+
+void ContentionManager::AfterConflict(const Transaction &txn, VersionSkipList *row_list) {
+    auto now = std::chrono::steady_clock::now();
+    if (policy_ == ContentionPolicy::WAIT_DIE) {
+        // The retry would die again while the holder runs.
+        WaitRelease(row_list, txn.txn_id_, now + max_wait_);
+    } else if (policy_ == ContentionPolicy::BACKOFF) {
+        thread_local std::mt19937 generator(std::random_device{}());
+        auto conflicts = std::min<idx_t>(row_list->conflict_count.load(), 16);
+        auto limit = std::min<idx_t>(max_wait_.count(), MIN_BACKOFF_US << conflicts);
+        auto backoff = std::chrono::microseconds(std::uniform_int_distribution<idx_t>(limit / 2, limit)(generator));
+        // No early wake up at the release: waking every loser at once only moves the storm.
+        std::this_thread::sleep_until(now + backoff);
+    }
+}
+
+void ContentionManager::Release(VersionSkipList *row_list) {
+    auto &stripe = StripeOf(row_list);
+    if (stripe.waiters.load() == 0) {
+        return;
+    }
+    {
+        std::unique_lock lock(stripe.latch);
+    }
+    stripe.cv.notify_all();
+}
+
+}
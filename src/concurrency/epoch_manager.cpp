@@ -0,0 +1,142 @@
+#include "concurrency/epoch_manager.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace babydb {
+
+//! Per-thread part of the epoch manager. Leftover retired objects are handed over when the thread exits.
+struct EpochManager::ThreadState {
+    idx_t slot_id{INVALID_ID};
+
+    idx_t nesting{0};
+
+    std::vector<RetiredObject> retired;
+
+    ~ThreadState() {
+        if (slot_id != INVALID_ID) {
+            EpochManager::Instance().ReleaseSlot(slot_id, std::move(retired));
+        }
+    }
+};
+
+EpochManager& EpochManager::Instance() {
+    static EpochManager instance;
+    return instance;
+}
+
+EpochManager::~EpochManager() {
+    for (auto &retired : orphans_) {
+        retired.deleter(retired.object);
+    }
+}
+
+EpochManager::ThreadState& EpochManager::LocalState() {
+    thread_local ThreadState state;
+    if (state.slot_id == INVALID_ID) {
+        state.slot_id = AcquireSlot();
+    }
+    return state;
+}
+
+idx_t EpochManager::AcquireSlot() {
+    for (idx_t slot_id = 0; slot_id < MAX_THREADS; slot_id++) {
+        bool expected = false;
+        if (!slots_[slot_id].owned.load() && slots_[slot_id].owned.compare_exchange_strong(expected, true)) {
+            auto slot_count = slot_count_.load();
+            while (slot_count <= slot_id && !slot_count_.compare_exchange_weak(slot_count, slot_id + 1)) {
+                // loop until success
+            }
+            return slot_id;
+        }
+    }
+    throw std::logic_error("Too many threads reading versions.");
+}
+
+void EpochManager::ReleaseSlot(idx_t slot_id, std::vector<RetiredObject> &&retired) {
+    slots_[slot_id].epoch.store(0);
+    slots_[slot_id].owned.store(false);
+    std::unique_lock lock(orphans_latch_);
+    orphans_.insert(orphans_.end(), retired.begin(), retired.end());
+}
+
+void EpochManager::Enter() {
+    auto &state = LocalState();
+    if (state.nesting++ == 0) {
+        // seq_cst orders this store before every later load of the protected pointers.
+        slots_[state.slot_id].epoch.store(global_epoch_.load());
+    }
+}
+
+void EpochManager::Exit() {
+    auto &state = LocalState();
+    if (--state.nesting == 0) {
+        slots_[state.slot_id].epoch.store(0);
+    }
+}
+
+void EpochManager::Retire(void *object, Deleter deleter) {
+    auto &state = LocalState();
+    state.retired.push_back(RetiredObject{object, deleter, global_epoch_.load()});
+    if (state.nesting > 0) {
+        return;
+    }
+    // Without concurrent readers the object is freed right away; advancing the epoch is left to
+    // the batches, so a steady stream of retirements doesn't contend on it.
+    if (state.retired.size() >= RECLAIM_THRESHOLD) {
+        Reclaim();
+    } else {
+        FreeRetired(state.retired);
+    }
+}
+
+void EpochManager::Reclaim() {
+    auto &state = LocalState();
+    global_epoch_.fetch_add(1);
+    FreeRetired(state.retired);
+    std::unique_lock lock(orphans_latch_, std::try_to_lock);
+    if (lock.owns_lock()) {
+        FreeRetired(orphans_);
+    }
+}
+
+void EpochManager::HandOver() {
+    auto &state = LocalState();
+    if (state.retired.empty()) {
+        return;
+    }
+    std::unique_lock lock(orphans_latch_);
+    orphans_.insert(orphans_.end(), state.retired.begin(), state.retired.end());
+    state.retired.clear();
+}
+
+idx_t EpochManager::MinActiveEpoch() {
+    idx_t result = std::numeric_limits<idx_t>::max();
+    auto slot_count = slot_count_.load();
+    for (idx_t slot_id = 0; slot_id < slot_count; slot_id++) {
+        auto epoch = slots_[slot_id].epoch.load();
+        if (epoch != 0 && epoch < result) {
+            result = epoch;
+        }
+    }
+    return result;
+}
+
+void EpochManager::FreeRetired(std::vector<RetiredObject> &retired) {
+    if (retired.empty()) {
+        return;
+    }
+    // A reader that entered at epoch e may hold anything retired at epoch e or later.
+    auto min_active_epoch = MinActiveEpoch();
+    idx_t freed = 0;
+    for (auto &object : retired) {
+        if (object.epoch >= min_active_epoch) {
+            break;
+        }
+        object.deleter(object.object);
+        freed++;
+    }
+    retired.erase(retired.begin(), retired.begin() + freed);
+}
+
+}
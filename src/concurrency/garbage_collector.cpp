@@ -0,0 +1,152 @@
+#include "concurrency/garbage_collector.hpp"
+#include "concurrency/epoch_manager.hpp"
+#include "concurrency/version_link.hpp"
+
+#include <algorithm>
+
+namespace babydb {
+
+void RetireList::Retire(std::function<bool(VersionSkipList*)> owns, std::function<void()> release) {
+    {
+        std::unique_lock lock(latch_);
+        if (!closed_) {
+            owners_.push_back(Owner{std::move(owns), std::move(release)});
+            return;
+        }
+    }
+    release();
+}
+
+GarbageCollector::GarbageCollector(std::function<idx_t()> compute_watermark, idx_t interval_ms)
+    : compute_watermark_(std::move(compute_watermark)), interval_(interval_ms),
+      retired_(std::make_shared<RetireList>()) {
+    if (interval_ms > 0) {
+        thread_ = std::thread([this] { BackgroundLoop(); });
+    }
+}
+
+GarbageCollector::~GarbageCollector() {
+    {
+        std::unique_lock lock(stop_latch_);
+        stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    // The queue goes with the collector, the owners need not drop their lists from it.
+    std::vector<RetireList::Owner> owners;
+    {
+        std::unique_lock lock(retired_->latch_);
+        retired_->closed_ = true;
+        owners.swap(retired_->owners_);
+    }
+    for (auto &owner : owners) {
+        owner.release();
+    }
+    for (auto &[ts, row_list] : retired_rows_) {
+        delete row_list;
+    }
+}
+
+void GarbageCollector::AfterCommit(const std::vector<VersionSkipList*> &row_lists) {
+    if (row_lists.empty()) {
+        return;
+    }
+    // Announced before the watermark is computed, so Retains waits until it is published.
+    pruning_.fetch_add(1);
+    auto watermark = Publish(compute_watermark_());
+    pruning_.fetch_sub(1);
+    for (auto row_list : row_lists) {
+        if (row_list->garbage_collect(watermark)) {
+            Enqueue(row_list);
+        }
+    }
+}
+
+idx_t GarbageCollector::Publish(idx_t watermark) {
+    auto published = watermark_.load();
+    while (published < watermark && !watermark_.compare_exchange_weak(published, watermark)) {
+        // loop until success
+    }
+    return std::max(published, watermark);
+}
+
+void GarbageCollector::Enqueue(VersionSkipList *row_list) {
+    if (row_list->gc_queued.exchange(true)) {
+        return;
+    }
+    std::unique_lock lock(queue_latch_);
+    queue_.push_back(row_list);
+}
+
+void GarbageCollector::RetireRowList(VersionSkipList *row_list, idx_t ts) {
+    std::unique_lock lock(queue_latch_);
+    retired_rows_.emplace_back(ts, row_list);
+}
+
+void GarbageCollector::Collect() {
+    std::unique_lock collect_lock(collect_latch_);
+    auto watermark = Publish(compute_watermark_());
+    std::vector<RetireList::Owner> owners;
+    {
+        std::unique_lock lock(retired_->latch_);
+        owners.swap(retired_->owners_);
+    }
+    std::vector<VersionSkipList*> lists;
+    std::vector<VersionSkipList*> freed_rows;
+    {
+        std::unique_lock lock(queue_latch_);
+        lists.swap(queue_);
+        auto retired_end = std::partition(retired_rows_.begin(), retired_rows_.end(),
+                                          [watermark](auto &retired) { return retired.first >= watermark; });
+        for (auto iter = retired_end; iter != retired_rows_.end(); iter++) {
+            freed_rows.push_back(iter->second);
+        }
+        retired_rows_.erase(retired_end, retired_rows_.end());
+    }
+    for (auto row_list : freed_rows) {
+        delete row_list;
+    }
+    // No commit queues the lists of a retired owner anymore, so they are only in this batch.
+    if (!owners.empty()) {
+        lists.erase(std::remove_if(lists.begin(), lists.end(), [&owners](VersionSkipList *row_list) {
+            return std::any_of(owners.begin(), owners.end(), [row_list](auto &owner) { return owner.owns(row_list); });
+        }), lists.end());
+    }
+    for (auto row_list : lists) {
+        // Cleared first: a commit racing with this pass queues the list again.
+        row_list->gc_queued.store(false);
+        if (row_list->garbage_collect(watermark)) {
+            Enqueue(row_list);
+        }
+    }
+    for (auto &owner : owners) {
+        owner.release();
+    }
+    // A reader in the middle of a version list keeps the versions of this pass, the next Reclaim of any
+    // committing thread frees them instead of this thread's next pass.
+    EpochManager::Instance().Reclaim();
+    EpochManager::Instance().HandOver();
+}
+
+bool GarbageCollector::Retains(idx_t ts) {
+    // A pass or a commit that computed its watermark before the reader registered has published it by now.
+    // Commits only hold pruning_ for a few loads, so the wait is short.
+    std::unique_lock collect_lock(collect_latch_);
+    while (pruning_.load() != 0) {
+        std::this_thread::yield();
+    }
+    return ts >= watermark_.load();
+}
+
+void GarbageCollector::BackgroundLoop() {
+    std::unique_lock lock(stop_latch_);
+    while (!stop_cv_.wait_for(lock, interval_, [this] { return stop_; })) {
+        lock.unlock();
+        Collect();
+        lock.lock();
+    }
+}
+
+}
@@ -0,0 +1,84 @@
+#include "concurrency/lock_manager.hpp"
+#include "concurrency/transaction.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace babydb {
+
+LockManager::Partition& LockManager::PartitionOf(VersionSkipList *row_list) {
+    return partitions_[std::hash<VersionSkipList*>()(row_list) % PARTITION_COUNT];
+}
+
+static bool Compatible(LockMode held, LockMode wanted) {
+    return held == LockMode::SHARED && wanted == LockMode::SHARED;
+}
+
+bool LockManager::TryGrant(LockQueue &queue, std::list<Request>::iterator request) {
+    auto txn = request->txn;
+    bool blocked = false;
+    for (auto iter = queue.requests.begin(); iter != request; iter++) {
+        // The own shared lock of an upgrade doesn't block it.
+        if (iter->txn == txn) {
+            continue;
+        }
+        // FIFO: a waiting request ahead is served first.
+        if (!iter->granted || !Compatible(iter->mode, request->mode)) {
+            blocked = true;
+            // Smaller priorities are older, a retry keeps the age of its first attempt.
+            if (iter->txn->priority_ > txn->priority_) {
+                iter->txn->Wound();
+            }
+        }
+    }
+    return !blocked;
+}
+
+void LockManager::Lock(Transaction &txn, VersionSkipList *row_list, LockMode mode, bool upgrade) {
+    auto &partition = PartitionOf(row_list);
+    std::unique_lock latch(partition.latch);
+    auto &queue = partition.queues[row_list];
+    // An upgrade goes before the waiting requests, they wait for the shared lock it holds anyway.
+    auto position = queue.requests.end();
+    if (upgrade) {
+        position = std::find_if(queue.requests.begin(), queue.requests.end(),
+                                [](const Request &request) { return !request.granted; });
+    }
+    auto request = queue.requests.insert(position, Request{&txn, mode, false});
+    while (!TryGrant(queue, request)) {
+        if (txn.Wounded()) {
+            queue.requests.erase(request);
+            // The requests behind it may be grantable now.
+            queue.cv.notify_all();
+            throw TaintedException("Wounded by an older transaction");
+        }
+        queue.cv.wait_for(latch, WOUND_CHECK_INTERVAL);
+    }
+    request->granted = true;
+    if (upgrade) {
+        queue.requests.remove_if([&txn](const Request &shared) {
+            return shared.txn == &txn && shared.mode == LockMode::SHARED;
+        });
+    }
+}
+
+void LockManager::ReleaseAll(Transaction &txn) {
+    for (auto &[row_list, row_lock] : txn.row_locks_) {
+        auto &partition = PartitionOf(row_list);
+        std::unique_lock latch(partition.latch);
+        auto iter = partition.queues.find(row_list);
+        if (iter == partition.queues.end()) {
+            continue;
+        }
+        auto &queue = iter->second;
+        queue.requests.remove_if([&txn](const Request &request) { return request.txn == &txn; });
+        if (queue.requests.empty()) {
+            partition.queues.erase(iter);
+        } else {
+            queue.cv.notify_all();
+        }
+    }
+    txn.row_locks_.clear();
+}
+
+}
@@ -0,0 +1,54 @@
+#include "concurrency/mvcc_control.hpp"
+#include "concurrency/transaction.hpp"
+
+namespace babydb {
+
+void MvccControl::Begin(Transaction &txn) {
+    // Snapshot isolation needs no tracking at all.
+    if (isolation_level_ == IsolationLevel::SERIALIZABLE) {
+        txn.concurrency_control_ = this;
+        txn.tracks_reads_ = true;
+        txn.ssi_info_ = std::make_shared<SsiTxnInfo>(txn.txn_id_, txn.read_ts_);
+    }
+}
+
+void MvccControl::OnRead(Transaction &txn, VersionSkipList *row_list) {
+    ssi_.OnRead(txn.ssi_info_, row_list);
+}
+
+void MvccControl::OnRangeRead(Transaction &txn, SsiPredicateLocks &locks, const RangeInfo &range) {
+    ssi_.OnRangeRead(txn.ssi_info_, locks, range);
+}
+
+void MvccControl::OnWrite(Transaction &txn, VersionSkipList *row_list) {
+    ssi_.OnWrite(txn.ssi_info_, row_list);
+}
+
+void MvccControl::OnInsert(Transaction &txn, SsiPredicateLocks &locks, data_t key) {
+    ssi_.OnInsert(txn.ssi_info_, locks, key);
+}
+
+bool MvccControl::PreCommit(Transaction &txn, const std::function<idx_t()> &allocate_ts) {
+    if (!txn.ssi_info_) {
+        // A read-only snapshot needs neither validation nor a new ts, it is serialized at its read ts.
+        txn.commit_ts_ = txn.ReadOnly() ? txn.read_ts_ : allocate_ts();
+        return true;
+    }
+    if (txn.ReadOnly()) {
+        // Never a pivot, it only aborts as the reader of a committed pivot.
+        if (!ssi_.PreCommit(*txn.ssi_info_, [&txn] { return txn.read_ts_; })) {
+            return false;
+        }
+        txn.commit_ts_ = txn.read_ts_;
+        return true;
+    }
+    // Checks and ts allocation are serialized, so every out-neighbor marked committed got a smaller ts.
+    std::unique_lock commit_lock(commit_latch_);
+    return ssi_.PreCommit(*txn.ssi_info_, [&txn, &allocate_ts] { return txn.commit_ts_ = allocate_ts(); });
+}
+
+void MvccControl::Finish(Transaction &txn, bool committed) {
+    ssi_.Finish(*txn.ssi_info_, committed);
+}
+
+}
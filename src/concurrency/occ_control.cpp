@@ -0,0 +1,57 @@
+#include "concurrency/occ_control.hpp"
+#include "concurrency/ssi.hpp"
+#include "concurrency/transaction.hpp"
+#include "concurrency/version_link.hpp"
+
+namespace babydb {
+
+void OccControl::Begin(Transaction &txn) {
+    txn.concurrency_control_ = this;
+    txn.tracks_reads_ = true;
+}
+
+void OccControl::OnRead(Transaction &txn, VersionSkipList *row_list) {
+    txn.read_rows_.push_back(row_list);
+}
+
+void OccControl::OnRangeRead(Transaction &txn, SsiPredicateLocks &locks, const RangeInfo &) {
+    // Taken before the scan: a key inserted later changes the count, one inserted earlier is read as a row.
+    txn.read_ranges_.emplace_back(&locks, locks.insert_count.load());
+}
+
+void OccControl::OnInsert(Transaction &txn, SsiPredicateLocks &locks, data_t) {
+    txn.insert_ranges_.push_back(&locks);
+}
+
+bool OccControl::PreCommit(Transaction &txn, const std::function<idx_t()> &allocate_ts) {
+    if (txn.ReadOnly()) {
+        txn.commit_ts_ = txn.read_ts_;
+        return true;
+    }
+    // Counted before the ts is taken: a scan that validates before the count missed the key, and gets a smaller
+    // ts than a scan that validates after it. A scan that ran after the key was linked read it as a row.
+    for (auto locks : txn.insert_ranges_) {
+        locks->insert_count.fetch_add(1);
+        for (auto &[read_locks, insert_count] : txn.read_ranges_) {
+            if (read_locks == locks) {
+                insert_count++;
+            }
+        }
+    }
+    // The written rows are claimed already, like the locked write set of Silo. The ts is taken before
+    // the checks, so a writer claiming a row read here after its check passed gets a larger ts.
+    txn.commit_ts_ = allocate_ts();
+    for (auto &[locks, insert_count] : txn.read_ranges_) {
+        if (locks->insert_count.load() != insert_count) {
+            return false;
+        }
+    }
+    for (auto row_list : txn.read_rows_) {
+        if (!row_list->validate_read(txn.read_ts_, txn.txn_id_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
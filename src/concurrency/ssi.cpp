@@ -0,0 +1,128 @@
+#include "concurrency/ssi.hpp"
+#include "concurrency/garbage_collector.hpp"
+#include "concurrency/version_link.hpp"
+
+#include <algorithm>
+
+namespace babydb {
+
+//! `reader` saw a version older than one written by the concurrent `writer`.
+static bool Concurrent(const SsiTxnInfo &reader, const SsiTxnInfo &writer) {
+    if (&reader == &writer || reader.aborted.load() || writer.aborted.load()) {
+        return false;
+    }
+    auto reader_commit = reader.commit_ts.load();
+    auto writer_commit = writer.commit_ts.load();
+    return (reader_commit == INVALID_ID || reader_commit > writer.read_ts)
+        && (writer_commit == INVALID_ID || writer_commit > reader.read_ts);
+}
+
+static bool InRange(const RangeInfo &range, data_t key) {
+    return (range.contain_start ? key >= range.start : key > range.start)
+        && (range.contain_end ? key <= range.end : key < range.end);
+}
+
+void SsiManager::AddEdge(const std::shared_ptr<SsiTxnInfo> &reader, const std::shared_ptr<SsiTxnInfo> &writer) {
+    {
+        std::unique_lock lock(reader->latch);
+        // A finished reader never checks its out-edges again.
+        if (reader->commit_ts.load() == INVALID_ID && std::find(reader->out_edges.begin(), reader->out_edges.end(), writer) == reader->out_edges.end()) {
+            reader->out_edges.push_back(writer);
+        }
+    }
+    bool doom_reader;
+    {
+        std::unique_lock lock(writer->latch);
+        writer->in_conflict = true;
+        doom_reader = writer->commit_ts.load() != INVALID_ID && writer->committed_pivot;
+    }
+    if (doom_reader) {
+        std::unique_lock lock(reader->latch);
+        reader->doomed = true;
+    }
+}
+
+void SsiManager::Prune(std::vector<std::shared_ptr<SsiTxnInfo>> &infos, idx_t watermark) {
+    infos.erase(std::remove_if(infos.begin(), infos.end(),
+        [watermark](const std::shared_ptr<SsiTxnInfo> &info) { return info->Obsolete(watermark); }), infos.end());
+}
+
+void SsiManager::OnRead(const std::shared_ptr<SsiTxnInfo> &reader, VersionSkipList *row_list) {
+    auto &state = *row_list->GetSsiState();
+    std::unique_lock lock(state.latch);
+    auto watermark = gc_.GetWatermark();
+    Prune(state.readers, watermark);
+    Prune(state.writers, watermark);
+    if (std::find(state.readers.begin(), state.readers.end(), reader) == state.readers.end()) {
+        state.readers.push_back(reader);
+    }
+    for (auto &writer : state.writers) {
+        if (Concurrent(*reader, *writer)) {
+            AddEdge(reader, writer);
+        }
+    }
+}
+
+void SsiManager::OnWrite(const std::shared_ptr<SsiTxnInfo> &writer, VersionSkipList *row_list) {
+    auto &state = *row_list->GetSsiState();
+    std::unique_lock lock(state.latch);
+    auto watermark = gc_.GetWatermark();
+    Prune(state.readers, watermark);
+    Prune(state.writers, watermark);
+    if (std::find(state.writers.begin(), state.writers.end(), writer) == state.writers.end()) {
+        state.writers.push_back(writer);
+    }
+    for (auto &reader : state.readers) {
+        if (Concurrent(*reader, *writer)) {
+            AddEdge(reader, writer);
+        }
+    }
+}
+
+void SsiManager::OnRangeRead(const std::shared_ptr<SsiTxnInfo> &reader, SsiPredicateLocks &locks, const RangeInfo &range) {
+    std::unique_lock lock(locks.latch_);
+    if (locks.markers_.size() >= locks.prune_size_) {
+        auto watermark = gc_.GetWatermark();
+        auto &markers = locks.markers_;
+        markers.erase(std::remove_if(markers.begin(), markers.end(),
+            [watermark](const SsiPredicateLocks::RangeMarker &marker) { return marker.reader->Obsolete(watermark); }), markers.end());
+        locks.prune_size_ = std::max<idx_t>(64, 2 * markers.size());
+    }
+    locks.markers_.push_back(SsiPredicateLocks::RangeMarker{range, reader});
+}
+
+void SsiManager::OnInsert(const std::shared_ptr<SsiTxnInfo> &writer, SsiPredicateLocks &locks, data_t key) {
+    std::unique_lock lock(locks.latch_);
+    for (auto &marker : locks.markers_) {
+        if (InRange(marker.range, key) && Concurrent(*marker.reader, *writer)) {
+            AddEdge(marker.reader, writer);
+        }
+    }
+}
+
+bool SsiManager::PreCommit(SsiTxnInfo &info, const std::function<idx_t()> &allocate_ts) {
+    std::unique_lock lock(info.latch);
+    if (info.doomed) {
+        return false;
+    }
+    // Writers commit in ts order under the commit latch, so a committed out-neighbor committed first.
+    bool committed_out = std::any_of(info.out_edges.begin(), info.out_edges.end(),
+        [](const std::shared_ptr<SsiTxnInfo> &writer) { return !writer->aborted.load() && writer->commit_ts.load() != INVALID_ID; });
+    if (info.in_conflict && committed_out) {
+        return false;
+    }
+    info.committed_pivot = committed_out;
+    info.commit_ts.store(allocate_ts());
+    return true;
+}
+
+void SsiManager::Finish(SsiTxnInfo &info, bool committed) {
+    if (!committed) {
+        info.aborted.store(true);
+    }
+    std::unique_lock lock(info.latch);
+    // Dropping the edges breaks reference cycles between transactions that read each other's writes.
+    info.out_edges.clear();
+}
+
+}
@@ -1,9 +1,114 @@
 #include "concurrency/transaction.hpp"
+#include "concurrency/admission_controller.hpp"
+#include "concurrency/contention_manager.hpp"
+#include "concurrency/concurrency_control.hpp"
+#include "concurrency/version_link.hpp"
+#include "storage/index.hpp"
+#include "storage/table.hpp"
+
+#include <algorithm>
 
 namespace babydb {
 
 void Transaction::Done() {
-    db_lock_.unlock();
+    catalog_.reset();
+}
+
+void Transaction::Admit() {
+    // Waiting with row locks could block the admitted writers that wait for them.
+    admission_->Acquire(row_locks_.empty());
+    admitted_ = true;
+}
+
+void Transaction::AddModifiedRow(VersionSkipList *row_list) {
+    modified_rows_.push_back(row_list);
+    if (concurrency_control_) {
+        concurrency_control_->OnWrite(*this, row_list);
+    }
+}
+
+void Transaction::AddDeltaRow(VersionSkipList *row_list, DeltaMaterializer &&materialize) {
+    delta_rows_.emplace_back(row_list, std::move(materialize));
+    if (concurrency_control_) {
+        concurrency_control_->OnWrite(*this, row_list);
+    }
+}
+
+void Transaction::BeforeWrite(VersionSkipList *row_list) {
+    if (contention_manager_) {
+        contention_manager_->BeforeWrite(*this, row_list);
+    }
+}
+
+void Transaction::BeforeIndexWrite(Index &index) {
+    // A transaction writes few indexes, a linear search is enough.
+    if (std::find(written_indexes_.begin(), written_indexes_.end(), &index) != written_indexes_.end()) {
+        return;
+    }
+    try {
+        index.AddWriter();
+    } catch (TaintedException &e) {
+        SetTainted();
+        throw;
+    }
+    written_indexes_.push_back(&index);
+}
+
+void Transaction::AddReadRow(VersionSkipList *row_list) {
+    if (tracks_reads_) {
+        concurrency_control_->OnRead(*this, row_list);
+    }
+}
+
+void Transaction::AddReadRange(SsiPredicateLocks &locks, const RangeInfo &range) {
+    if (tracks_reads_) {
+        concurrency_control_->OnRangeRead(*this, locks, range);
+    }
+}
+
+void Transaction::AddInsertedKey(Index &index, VersionSkipList *row_list, SsiPredicateLocks &locks, data_t key) {
+    inserted_rows_.emplace_back(&index, row_list);
+    if (concurrency_control_) {
+        concurrency_control_->OnInsert(*this, locks, key);
+    }
+}
+
+bool Transaction::LocksRows(const Table &table) const {
+    return lock_manager_ && (row_locking_ || table.RowLocking());
+}
+
+idx_t Transaction::LockRow(VersionSkipList *row_list, LockMode mode) {
+    auto iter = row_locks_.find(row_list);
+    if (iter != row_locks_.end() && (iter->second.mode == LockMode::EXCLUSIVE || mode == LockMode::SHARED)) {
+        return iter->second.read_ts;
+    }
+    if (Wounded()) {
+        SetTainted();
+        throw TaintedException("Wounded by an older transaction");
+    }
+    bool upgrade = iter != row_locks_.end();
+    try {
+        lock_manager_->Lock(*this, row_list, mode, upgrade);
+    } catch (TaintedException &e) {
+        SetTainted();
+        throw;
+    }
+    if (upgrade) {
+        // A commit after the shared lock can only come from a txn without locks, the write then conflicts.
+        iter->second.mode = LockMode::EXCLUSIVE;
+        return iter->second.read_ts;
+    }
+    auto read_ts = row_list->lastcommitts.load();
+    row_locks_.emplace(row_list, RowLock{mode, read_ts});
+    return read_ts;
 }
 
-}
\ No newline at end of file
+idx_t Transaction::WriteTs(VersionSkipList *row_list) const {
+    if (row_locks_.empty()) {
+        return read_ts_;
+    }
+    auto iter = row_locks_.find(row_list);
+    return iter == row_locks_.end() ? read_ts_ : iter->second.read_ts;
+}
+
+}
@@ -1,67 +1,221 @@
 #include "concurrency/transaction_manager.hpp"
+#include "concurrency/admission_controller.hpp"
+#include "concurrency/contention_manager.hpp"
+#include "concurrency/concurrency_control.hpp"
+#include "concurrency/lock_manager.hpp"
 #include "concurrency/version_link.hpp"
+#include "storage/index.hpp"
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 namespace babydb {
 
-std::shared_ptr<Transaction> TransactionManager::CreateTxn(std::shared_lock<std::shared_mutex> &&db_lock) {
-    std::unique_lock lock(txn_map_latch_);
-    // Update gcts to be the minimum read_ts_ among all active transactions
-    idx_t min_read_ts = last_commit_ts_; // Initialize with last commit timestamp
-    for (const auto& [txn_id, txn] : txn_map_) {
-        if (txn->state_ == RUNNING && txn->read_ts_ < min_read_ts) {
-            min_read_ts = txn->read_ts_;
-        }
+TransactionManager::TransactionManager(const ConfigGroup &config) : history_retention_(config.HISTORY_RETENTION),
+    gc_(std::make_unique<GarbageCollector>([this] { return ComputeWatermark(); }, config.GC_INTERVAL_MS)),
+    concurrency_control_(ConcurrencyControl::Create(config, *gc_)),
+    contention_(std::make_unique<ContentionManager>(config.CONTENTION_POLICY, config.MAX_CONTENTION_WAIT_US)),
+    lock_manager_(config.CONCURRENCY_CONTROL == ConcurrencyControlType::MVCC ? std::make_unique<LockManager>() : nullptr),
+    admission_(std::make_unique<AdmissionController>(config.MAX_WRITE_TXNS)) {}
+
+TransactionManager::~TransactionManager() = default;
+
+std::shared_ptr<Transaction> TransactionManager::CreateTxn(std::shared_ptr<const Catalog> catalog, bool row_locking,
+                                                           idx_t priority) {
+    auto txn_id = next_txn_id_.fetch_add(1);
+    auto [read_ts, shard_id] = active_txns_.Register(visible_ts_);
+    auto result = std::make_shared<Transaction>(txn_id, read_ts, std::move(catalog), priority);
+    result->registry_shard_ = shard_id;
+    if (contention_->Enabled()) {
+        result->contention_manager_ = contention_.get();
+        contention_->Register(*result);
+    }
+    result->lock_manager_ = lock_manager_.get();
+    if (admission_->Enabled()) {
+        result->admission_ = admission_.get();
     }
-    auto result = std::make_shared<Transaction>(next_txn_id_, last_commit_ts_, min_read_ts, std::move(db_lock));
-    txn_map_.insert(std::make_pair(next_txn_id_, result));
-    next_txn_id_++;
+    result->row_locking_ = row_locking;
+    concurrency_control_->Begin(*result);
     return result;
 }
 
-bool TransactionManager::VerifyTxn([[maybe_unused]] Transaction &txn)
-{
-    if (isolation_level_ == IsolationLevel::SNAPSHOT)
-    {
-        return true;
+std::shared_ptr<Transaction> TransactionManager::CreateTxnAsOf(idx_t ts, std::shared_ptr<const Catalog> catalog) {
+    if (ts > visible_ts_.load()) {
+        throw std::logic_error("AS OF a timestamp not committed yet.");
+    }
+    auto txn_id = next_txn_id_.fetch_add(1);
+    auto shard_id = active_txns_.RegisterAt(ts);
+    if (!gc_->Retains(ts)) {
+        active_txns_.Unregister(shard_id, ts);
+        throw std::logic_error("AS OF a timestamp older than the retained history.");
     }
+    // Not attached to the concurrency control nor the contention manager: it never writes,
+    // and its reads are serialized at ts.
+    auto result = std::make_shared<Transaction>(txn_id, ts, std::move(catalog));
+    result->registry_shard_ = shard_id;
+    result->read_only_ = true;
+    return result;
+}
 
-    for (auto i = txn.read_rows_.begin(); i != txn.read_rows_.end(); i++)
+idx_t TransactionManager::CreateSnapshot(const std::string &name) {
+    // Registered like a transaction meanwhile, so the versions at ts can't go before the snapshot pins them.
+    auto [ts, shard_id] = active_txns_.Register(visible_ts_);
     {
-        if ((*i)->lastcommitts > txn.read_ts_)
-        {
-            return false;
+        std::unique_lock lock(snapshot_latch_);
+        if (!snapshots_.emplace(name, ts).second) {
+            active_txns_.Unregister(shard_id, ts);
+            throw std::logic_error("Snapshot " + name + " exists already.");
         }
+        PublishSnapshotMin();
     }
+    active_txns_.Unregister(shard_id, ts);
+    return ts;
+}
 
-    return true;
+void TransactionManager::DropSnapshot(const std::string &name) {
+    std::unique_lock lock(snapshot_latch_);
+    if (snapshots_.erase(name) == 0) {
+        throw std::logic_error("Snapshot " + name + " does not exist.");
+    }
+    PublishSnapshotMin();
+}
+
+void TransactionManager::PublishSnapshotMin() {
+    idx_t snapshot_min = INVALID_ID;
+    for (auto &[name, ts] : snapshots_) {
+        snapshot_min = std::min(snapshot_min, ts);
+    }
+    snapshot_min_.store(snapshot_min);
+}
+
+idx_t TransactionManager::GetSnapshotTs(const std::string &name) {
+    std::unique_lock lock(snapshot_latch_);
+    auto iter = snapshots_.find(name);
+    if (iter == snapshots_.end()) {
+        throw std::logic_error("Snapshot " + name + " does not exist.");
+    }
+    return iter->second;
+}
+
+idx_t TransactionManager::GetAdmissionLimit() {
+    return admission_->GetLimit();
+}
+
+idx_t TransactionManager::ComputeWatermark() {
+    auto last_commit_ts = visible_ts_.load();
+    auto watermark = active_txns_.Watermark(visible_ts_);
+    if (last_commit_ts > history_retention_) {
+        watermark = std::min(watermark, last_commit_ts - history_retention_);
+    } else {
+        watermark = 0;
+    }
+    return std::min(watermark, snapshot_min_.load());
+}
+
+void TransactionManager::Finish(Transaction &txn, TransactionState state) {
+    if (txn.concurrency_control_) {
+        txn.concurrency_control_->Finish(txn, state == COMMITED);
+    }
+    // Strict 2PL: the locks go after the versions are installed or rolled back.
+    if (!txn.row_locks_.empty()) {
+        lock_manager_->ReleaseAll(txn);
+    }
+    if (txn.admitted_) {
+        admission_->Release(state == COMMITED);
+    }
+    // The rows of txn are installed or rolled back, no writer finds it as a holder anymore.
+    if (txn.contention_manager_) {
+        contention_->Unregister(txn);
+    }
+    // The rows written through the indexes are in the table or rolled back.
+    for (auto index : txn.written_indexes_) {
+        index->RemoveWriter();
+    }
+    txn.written_indexes_.clear();
+    active_txns_.Unregister(txn.registry_shard_, txn.read_ts_);
+    txn.state_ = state;
+}
+
+void TransactionManager::WaitForPredecessors(idx_t commit_ts) {
+    // The commits with smaller timestamps are installing already, they mostly publish within a few spins.
+    for (idx_t spin = 0; spin < PUBLISH_SPINS; spin++) {
+        if (visible_ts_.load() == commit_ts - 1) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+    // A predecessor was descheduled, sleep until it publishes. Registered before the check, so a publish
+    // after it sees the waiter.
+    publish_waiters_.fetch_add(1);
+    {
+        std::unique_lock lock(publish_latch_);
+        publish_cv_.wait(lock, [this, commit_ts] { return visible_ts_.load() == commit_ts - 1; });
+    }
+    publish_waiters_.fetch_sub(1);
+}
+
+void TransactionManager::Publish(idx_t commit_ts) {
+    visible_ts_.store(commit_ts);
+    if (publish_waiters_.load() != 0) {
+        // A waiter between its check and its wait holds the latch.
+        { std::unique_lock lock(publish_latch_); }
+        publish_cv_.notify_all();
+    }
+}
+
+void TransactionManager::InstallAndPublish(Transaction &txn) {
+    // Writers of the same row are serialized by its uncommitted slot, so installs of different
+    // transactions run concurrently. Readers ignore the new versions until the frontier passes them.
+    for (auto rid = txn.modified_rows_.begin(); rid != txn.modified_rows_.end(); rid++)
+    {
+        // Only the owner reads the data of its uncommitted version.
+        Datalist* own = (*rid)->uncommitted;
+        if (own && own->txn_id == txn.txn_id_) {
+            own->data = txn.write_set_.InstalledRow(own->data);
+        }
+        (*rid)->commit(txn.commit_ts_);
+    }
+    WaitForPredecessors(txn.commit_ts_);
+    // Deltas build on the newest version, so they are applied in commit ts order.
+    for (auto &[row_list, materialize] : txn.delta_rows_) {
+        Datalist* head = row_list->newest;
+        auto row_id = materialize(head->data, row_list->get_deltas(txn.txn_id_));
+        row_list->commit_deltas(row_id, txn.commit_ts_, txn.txn_id_);
+    }
+    Publish(txn.commit_ts_);
+    if (contention_->Enabled()) {
+        for (auto rid = txn.modified_rows_.begin(); rid != txn.modified_rows_.end(); rid++) {
+            contention_->Release(*rid);
+        }
+    }
 }
+
 bool TransactionManager::Commit(Transaction &txn) {
     if (txn.state_ != RUNNING) {
         throw std::logic_error("Try to commit a not running transaction."); 
     }
-    std::unique_lock commit_lock(commit_latch_);
-    if (!VerifyTxn(txn)) {
-        commit_lock.unlock();
+    // An older txn waits for the locks of a wounded one.
+    if (txn.Wounded()) {
         Abort(txn);
         return false;
     }
-    // Project 2: Commit the txn
-    txn.commit_ts_ = last_commit_ts_ + 1;
-    for (auto rid = txn.modified_rows_.begin(); rid != txn.modified_rows_.end(); rid++)
-    {
-        (*rid)->commit(txn.commit_ts_);
+    if (!concurrency_control_->PreCommit(txn, [this] { return next_commit_ts_.fetch_add(1); })) {
+        Abort(txn);
+        return false;
     }
-    // gc 
-    for (auto rid = txn.read_rows_.begin(); rid != txn.read_rows_.end(); rid++) {
-        (*rid)->garbage_collect(txn.gc_ts_);
+    if (!txn.ReadOnly()) {
+        txn.write_set_.Install();
+        InstallAndPublish(txn);
+    }
+    Finish(txn, COMMITED);
+
+    // The txn still holds its catalog version, so the lists can't be dropped meanwhile.
+    std::vector<VersionSkipList*> written_rows(txn.modified_rows_);
+    for (auto &delta_row : txn.delta_rows_) {
+        written_rows.push_back(delta_row.first);
     }
-    
-    std::unique_lock map_lock(txn_map_latch_);
-    last_commit_ts_++;
-    txn.state_ = COMMITED;
+    gc_->AfterCommit(written_rows);
     txn.Done();
-    txn_map_.erase(txn.txn_id_);
     return true;
 }
 //! The txn should roll back. We do not implement it.
@@ -69,20 +223,41 @@ void TransactionManager::Abort(Transaction &txn) {
     if (txn.state_ != RUNNING && txn.state_ != TAINTED) {
         throw std::logic_error("Try to abort a not running or tainted transaction."); 
     }
-    // Project 2: Rollback the txn
-    std::unique_lock abort_lock(commit_latch_);
-
+    // Project 2: Rollback the txn. Each row checks the owner under its own latch.
     for (auto rid = txn.modified_rows_.begin(); rid != txn.modified_rows_.end(); rid++)
     {
         (*rid)->rollback(txn.txn_id_);
+        if (contention_->Enabled()) {
+            contention_->Release(*rid);
+        }
+    }
+    for (auto &delta_row : txn.delta_rows_) {
+        delta_row.first->rollback_deltas(txn.txn_id_);
+    }
+    // The new keys of txn leave the index again. Readers that found a list before it was unlinked read at the
+    // last commit ts or below.
+    for (auto &[index, row_list] : txn.inserted_rows_) {
+        if (index->EraseIfEmpty(row_list)) {
+            gc_->RetireRowList(row_list, visible_ts_.load());
+        }
+    }
+    // A commit ts taken by a failed check is published without versions, later commits wait for it.
+    if (txn.commit_ts_ != INVALID_ID) {
+        WaitForPredecessors(txn.commit_ts_);
+        Publish(txn.commit_ts_);
     }
 
-    std::unique_lock map_lock(txn_map_latch_);
-    txn.state_ = ABORTED;
+    Finish(txn, ABORTED);
+    // The txn still holds its catalog version, the row can't be dropped while waiting.
+    if (txn.conflict_row_ && contention_->Enabled()) {
+        contention_->AfterConflict(txn, txn.conflict_row_);
+    } else if (txn.conflict_row_) {
+        // A retry right away mostly meets the same holder, let it run first.
+        std::this_thread::yield();
+    }
     txn.Done();
-    txn_map_.erase(txn.txn_id_);
 
     //throw std::logic_error("Txn Abort is not implemented.");
 }
 
-}
\ No newline at end of file
+}
@@ -1,7 +1,9 @@
 #include "concurrency/version_link.hpp"
+#include "concurrency/epoch_manager.hpp"
+#include "concurrency/ssi.hpp"
 
+#include <algorithm>
 #include <atomic>
-#include <random>
 #include <iostream>
 #include <mutex>
 
@@ -26,158 +28,273 @@ void UnregisterVersionNode() {
 
 // END: Do not modify this part.
 
-void VersionSkipList::insert_list(data_t data_in, idx_t ts, idx_t txn_id) {
-    std::random_device rd;
-    std::mt19937 generator(rd());
-    int i = 0;
-    while (i < MAXLEVEL - 1 && generator() & 1) {
-        i++;
+static void RetireVersion(Datalist* version) {
+    EpochManager::Instance().Retire(version, [](void *object) { delete static_cast<Datalist*>(object); });
+}
+
+VersionSkipList::~VersionSkipList() {
+    destroy_list(newest);
+    delete uncommitted.load();
+    delete index_.load();
+    delete ssi_state_.load();
+}
+
+SsiRowState* VersionSkipList::GetSsiState() {
+    SsiRowState* state = ssi_state_;
+    if (!state) {
+        auto created = new SsiRowState();
+        if (ssi_state_.compare_exchange_strong(state, created)) {
+            state = created;
+        } else {
+            delete created;
+        }
     }
+    return state;
+}
 
-    Datalist* x = data[MAXLEVEL - 1];
-    int level = MAXLEVEL - 1;
-    Datalist* newterm = new Datalist(ts, data_in, txn_id);
+void VersionSkipList::insert_list(data_t data_in, idx_t ts, idx_t txn_id) {
+    link_version(new Datalist(ts, data_in, txn_id));
+}
 
-    if (!x) {
-        for (int i = 0; i < MAXLEVEL; i++) {
-            data[i] = newterm;
+void VersionSkipList::link_version(Datalist* newterm) {
+    auto ts = newterm->ts;
+    Datalist* head = newest;
+    if (!head || head->ts <= ts) {
+        newterm->next = head;
+        newest = newterm;
+    } else {
+        // Commits arrive in ts order, this only guards against an out of order install.
+        while (head->next.load() && head->next.load()->ts > ts) {
+            head = head->next;
         }
+        newterm->next = head->next.load();
+        head->next = newterm;
+    }
+    chain_length_++;
+    MaybeRebuildIndex();
+}
+
+void VersionSkipList::MaybeRebuildIndex() {
+    VersionIndex* index = index_;
+    if (chain_length_ < INDEX_THRESHOLD || (index && chain_length_ < 2 * index->versions.size())) {
         return;
     }
+    auto rebuilt = new VersionIndex();
+    rebuilt->versions.reserve(chain_length_);
+    // Versions are only unlinked under the latch, so the chain is complete here.
+    for (Datalist* node = newest; node; node = node->next) {
+        rebuilt->versions.emplace_back(node->ts, node->data);
+    }
+    std::reverse(rebuilt->versions.begin(), rebuilt->versions.end());
+    index_ = rebuilt;
+    if (index) {
+        EpochManager::Instance().Retire(index, [](void *object) { delete static_cast<VersionIndex*>(object); });
+    }
+}
 
-    while (x->ts > ts) {
-        if (level <= i) {
-            newterm->ptr[level] = x;
-            data[level] = newterm;
-            if (level == 0) return;
-        }
-        level--;
-        x = data[level];
-    }
-    Datalist* y = x;
-    while (true) {
-        x = x->ptr[level];
-        while (!x || (x->ts > ts)) {
-            if (level <= i) {
-                newterm->ptr[level] = x;
-                y->ptr[level] = newterm;
-                if (level == 0) return;
-            }
-            level--;
-            x = y->ptr[level];
-        }
-        y = x;
+void VersionSkipList::RetireIndex() {
+    VersionIndex* index = index_;
+    if (index) {
+        index_ = nullptr;
+        EpochManager::Instance().Retire(index, [](void *object) { delete static_cast<VersionIndex*>(object); });
     }
 }
 
+data_t VersionIndex::Search(idx_t ts) const {
+    auto iter = std::upper_bound(versions.begin(), versions.end(), ts,
+        [](idx_t ts, const std::pair<idx_t, data_t> &version) { return ts < version.first; });
+    if (iter == versions.begin()) {
+        return INVALID_ID;
+    }
+    return std::prev(iter)->second;
+}
+
 void VersionSkipList::insert_uncommitted_list(data_t data_in, idx_t ts, idx_t txn_id)
 {
     std::unique_lock listlock(list_latch_);
-    if ((uncommitted && (uncommitted->txn_id != txn_id)) || (lastcommitts > ts)) {
+    Datalist* old = uncommitted;
+    bool other_deltas = std::any_of(deltas_.begin(), deltas_.end(), [txn_id](const DeltaIntent &intent) { return intent.txn_id != txn_id; });
+    if ((old && (old->txn_id != txn_id)) || (lastcommitts > ts) || other_deltas) {
         listlock.unlock(); 
+        conflict_count.fetch_add(1, std::memory_order_relaxed);
+        throw TaintedException("Write conflict");
+    }
+    if (!deltas_.empty()) {
+        throw std::logic_error("A transaction can't both increment and overwrite a row.");
+    }
+    uncommitted = new Datalist(ts, data_in, txn_id);
+    if (old) {
+        RetireVersion(old);
+    }
+}
+
+bool VersionSkipList::insert_delta(idx_t txn_id, idx_t column, int64_t delta, const EscrowBound *bound,
+                                   const std::function<data_t(data_t)> &committed_value)
+{
+    std::unique_lock listlock(list_latch_);
+    Datalist* old = uncommitted;
+    if (old) {
+        if (old->txn_id == txn_id) {
+            throw std::logic_error("A transaction can't both increment and overwrite a row.");
+        }
+        conflict_count.fetch_add(1, std::memory_order_relaxed);
         throw TaintedException("Write conflict");
     }
-    Datalist* newterm = new Datalist(ts, data_in, txn_id);
-    if (uncommitted) {
-        delete uncommitted;
-        //UnregisterVersionNode();
-    } 
-    uncommitted = newterm;
-    RegisterVersionNode();
+    Datalist* head = newest;
+    if (!head) {
+        throw TaintedException("Increment of an uncommitted row");
+    }
+    if (bound) {
+        int64_t low = static_cast<int64_t>(committed_value(head->data));
+        int64_t high = low;
+        for (auto &intent : deltas_) {
+            if (intent.column == column) {
+                (intent.delta < 0 ? low : high) += intent.delta;
+            }
+        }
+        if ((delta < 0 && low + delta < static_cast<int64_t>(bound->min))
+            || (delta > 0 && high + delta > static_cast<int64_t>(bound->max))) {
+            throw TaintedException("Escrow bound");
+        }
+    }
+    bool first = true;
+    for (auto &intent : deltas_) {
+        if (intent.txn_id != txn_id) {
+            continue;
+        }
+        first = false;
+        // Increments and decrements of a txn are kept apart, so the escrow check sees both extremes.
+        if (intent.column == column && (intent.delta < 0) == (delta < 0)) {
+            intent.delta += delta;
+            return false;
+        }
+    }
+    deltas_.push_back(DeltaIntent{txn_id, column, delta});
+    return first;
+}
+
+std::vector<std::pair<idx_t, int64_t>> VersionSkipList::get_deltas(idx_t txn_id)
+{
+    std::unique_lock listlock(list_latch_);
+    std::vector<std::pair<idx_t, int64_t>> result;
+    for (auto &intent : deltas_) {
+        if (intent.txn_id == txn_id) {
+            result.emplace_back(intent.column, intent.delta);
+        }
+    }
+    return result;
+}
+
+void VersionSkipList::commit_deltas(data_t row_id, idx_t ts, idx_t txn_id)
+{
+    std::unique_lock listlock(list_latch_);
+    insert_list(row_id, ts, txn_id);
+    lastcommitts = ts;
+    rollback_deltas_locked(txn_id);
+}
+
+void VersionSkipList::rollback_deltas(idx_t txn_id)
+{
+    std::unique_lock listlock(list_latch_);
+    rollback_deltas_locked(txn_id);
+}
+
+void VersionSkipList::rollback_deltas_locked(idx_t txn_id)
+{
+    deltas_.erase(std::remove_if(deltas_.begin(), deltas_.end(),
+        [txn_id](const DeltaIntent &intent) { return intent.txn_id == txn_id; }), deltas_.end());
 }
 
 void VersionSkipList::commit(idx_t ts)
 {
     std::unique_lock listlock(list_latch_);
-    if (uncommitted){
-        insert_list(uncommitted->data, ts, uncommitted->txn_id);
-        delete uncommitted;
+    Datalist* old = uncommitted;
+    if (old){
+        // Readers of the uncommitted slot only look at its owner and data, so the version itself joins the chain
+        // instead of a copy. Its ts is set before the chain publishes it.
+        old->ts = ts;
+        link_version(old);
         uncommitted = nullptr;
         lastcommitts = ts; // update lastcommitts
+        conflict_count.store(conflict_count.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
     }
 }
 
 void VersionSkipList::rollback(idx_t txn_id)
 {
     std::unique_lock listlock(list_latch_);
-    if (uncommitted && (uncommitted->txn_id == txn_id)) {
-        delete uncommitted;
+    Datalist* old = uncommitted;
+    if (old && (old->txn_id == txn_id)) {
         uncommitted = nullptr;
-        //UnregisterVersionNode();
+        RetireVersion(old);
     }
 }
 
 
 data_t VersionSkipList::search_list(idx_t ts, idx_t txn_id)
 {
-    std::shared_lock listlock(list_latch_);
-    int level = MAXLEVEL - 1;
-    if (!data[level]) return INVALID_ID; // empty
-    if (uncommitted && (uncommitted->txn_id == txn_id)) return uncommitted->data; // should use locally uncommited
-
-    while (data[level]->ts > ts) {level--;}
-    Datalist* datanode = data[level];
-    while (1) {
-        while (!(datanode ->ptr[level]) || (datanode ->ptr[level]->ts > ts)) {
-            if (level == 0) return datanode ->data;
-            level--;
-        }
-        datanode  = datanode ->ptr[level];
-    }
-}
+    EpochGuard epoch_guard;
+    Datalist* own = uncommitted;
+    if (own && (own->txn_id == txn_id)) return own->data; // should use locally uncommited
 
-void VersionSkipList::garbage_collect(idx_t gc_ts) {
-    return ;
-    std::unique_lock lock(list_latch_);
-    
-    if (!data[MAXLEVEL-1]) {
-        return; 
+    // The index holds every version up to its last entry, except those no running reader can see.
+    VersionIndex* index = index_;
+    if (index && ts < index->versions.back().first) {
+        return index->Search(ts);
     }
-
-    Datalist* first_to_keep = data[MAXLEVEL-1];
-    std::vector<Datalist*> nodes_to_delete;
-    if(first_to_keep == nullptr){
-        return;
-    }
-    while (first_to_keep && first_to_keep->ts < gc_ts) {
-        nodes_to_delete.push_back(first_to_keep);
-        first_to_keep = first_to_keep->ptr[0];
-        if (!first_to_keep) {
-            break;
+    for (Datalist* node = newest; node; node = node->next) {
+        if (node->ts <= ts) {
+            return node->data;
         }
     }
+    return INVALID_ID; // empty, or created after the snapshot
+}
 
+bool VersionSkipList::is_empty()
+{
+    std::shared_lock listlock(list_latch_);
+    return !newest.load() && !uncommitted.load() && deltas_.empty();
+}
 
-    if (!first_to_keep) {
-        first_to_keep = nodes_to_delete.back(); 
-        nodes_to_delete.pop_back(); 
+bool VersionSkipList::validate_read(idx_t ts, idx_t txn_id)
+{
+    std::shared_lock listlock(list_latch_);
+    Datalist* holder = uncommitted;
+    if ((holder && holder->txn_id != txn_id) || lastcommitts > ts) {
+        return false;
     }
+    return std::all_of(deltas_.begin(), deltas_.end(), [txn_id](const DeltaIntent &intent) { return intent.txn_id == txn_id; });
+}
 
-    for (int level = MAXLEVEL-1; level >= 0; --level) {
-        Datalist* current = data[level];
-        Datalist* prev = nullptr;
-        
-        while (current && current->ts < gc_ts) {
-            prev = current;
-            current = current->ptr[level];
-        }
-
-        if (prev) {
-            prev->ptr[level] = first_to_keep;
-            if (level == 0) {
-                data[level] = first_to_keep; 
-            }
-        } else if (current != data[level]) {
-            data[level] = first_to_keep; 
-        }
+bool VersionSkipList::garbage_collect(idx_t gc_ts) {
+    std::unique_lock lock(list_latch_);
+    // Every running reader sees `keep` or something newer, so the versions behind it are unreachable.
+    Datalist* keep = newest;
+    idx_t kept = 1;
+    while (keep && keep->ts > gc_ts) {
+        keep = keep->next;
+        kept++;
     }
-
-    for (Datalist* node : nodes_to_delete) {
-        for (int i = 0; i < MAXLEVEL; ++i) {
-            node->ptr[i] = nullptr;
+    if (!keep) {
+        return newest.load() && newest.load()->next.load();
+    }
+    Datalist* old = keep->next;
+    if (old) {
+        keep->next = nullptr;
+        chain_length_ = kept;
+        // Readers stop at `keep` at the latest, the unlinked versions are only freed after they are gone.
+        while (old) {
+            Datalist* next = old->next;
+            RetireVersion(old);
+            old = next;
+        }
+        VersionIndex* index = index_;
+        if (index && (chain_length_ < INDEX_THRESHOLD || index->versions.size() > 2 * chain_length_)) {
+            RetireIndex();
+            MaybeRebuildIndex();
         }
-        delete node;
     }
+    return newest.load()->next.load() != nullptr;
 }
 
 
@@ -186,11 +303,11 @@ void destroy_list(Datalist* head)
 {
     if (head) {
         Datalist* headptr = head;
-        Datalist* ptr0 = headptr->ptr[0];
-        while (ptr0) {
+        Datalist* next = headptr->next;
+        while (next) {
             delete headptr;
-            headptr = ptr0;
-            ptr0 = ptr0->ptr[0];
+            headptr = next;
+            next = next->next;
         }
         delete headptr;
     }
@@ -0,0 +1,54 @@
+#include "concurrency/write_set.hpp"
+#include "storage/table.hpp"
+
+#include <stdexcept>
+
+namespace babydb {
+
+idx_t WriteSet::Write(Table &table, data_t key, Tuple &&tuple, bool &rewritten) {
+    // A transaction writes few tables, a linear search is enough.
+    idx_t table_no = 0;
+    while (table_no < tables_.size() && tables_[table_no].table != &table) {
+        table_no++;
+    }
+    if (table_no == tables_.size()) {
+        tables_.emplace_back();
+        tables_.back().table = &table;
+    }
+    auto &writes = tables_[table_no];
+    if (writes.base_row_id != INVALID_ID) {
+        throw std::logic_error("The write set is installed already.");
+    }
+    auto [slot, inserted] = writes.slots.emplace(key, writes.tuples.size());
+    rewritten = !inserted;
+    if (inserted) {
+        writes.tuples.push_back(std::move(tuple));
+    } else {
+        writes.tuples[slot->second] = std::move(tuple);
+    }
+    return LOCAL_ROW_FLAG | (table_no << TABLE_SHIFT) | slot->second;
+}
+
+const Tuple& WriteSet::LocalTuple(idx_t row_id) const {
+    return tables_[(row_id & ~LOCAL_ROW_FLAG) >> TABLE_SHIFT].tuples[row_id & SLOT_MASK];
+}
+
+void WriteSet::Install() {
+    for (auto &writes : tables_) {
+        auto write_guard = writes.table->GetWriteTableGuard();
+        auto &rows = write_guard.Rows();
+        writes.base_row_id = rows.size();
+        for (auto &tuple : writes.tuples) {
+            rows.push_back(Row{std::move(tuple), TupleMeta{}});
+        }
+    }
+}
+
+idx_t WriteSet::InstalledRow(idx_t row_id) const {
+    if (!IsLocalRow(row_id)) {
+        return row_id;
+    }
+    return tables_[(row_id & ~LOCAL_ROW_FLAG) >> TABLE_SHIFT].base_row_id + (row_id & SLOT_MASK);
+}
+
+}
@@ -1,70 +1,206 @@
 #include "execution/aggregate_operator.hpp"
 
+#include "common/config.hpp"
+#include "common/thread_pool.hpp"
+#include "execution/pipeline.hpp"
+
+#include <algorithm>
+
 namespace babydb {
 
-static Schema GetAggregateOutputSchema(const std::string &group_by, const std::string &aggregate_column) {
-    Schema result;
-    result.push_back(group_by);
-    result.push_back("SUM(" + aggregate_column + ")");
+static std::string GetAggregateName(const AggregateFunction &aggregate) {
+    static const char *type_names[] = {"COUNT", "SUM", "MIN", "MAX", "AVG"};
+    auto column_name = aggregate.column_name == INVALID_NAME ? "*" : aggregate.column_name;
+    return std::string(type_names[static_cast<idx_t>(aggregate.type)]) + "(" + column_name + ")";
+}
+
+static Schema GetAggregateOutputSchema(const Schema &group_by, const std::vector<AggregateFunction> &aggregates) {
+    Schema result = group_by;
+    for (auto &aggregate : aggregates) {
+        result.push_back(GetAggregateName(aggregate));
+    }
     return result;
 }
 
+AggregateOperator::AggregateOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
+                                     const Schema &group_by, const std::vector<AggregateFunction> &aggregates)
+    : Operator(exec_ctx, {child_operator}, GetAggregateOutputSchema(group_by, aggregates)), group_by_(group_by),
+      aggregates_(aggregates), reservation_(exec_ctx.memory_budget_) {}
+
 AggregateOperator::AggregateOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
                                      const std::string &group_by, const std::string &aggregate_column)
-    : Operator(exec_ctx, {child_operator}, GetAggregateOutputSchema(group_by, aggregate_column)), group_by_(group_by),
-      aggregate_column_(aggregate_column) {}
+    : AggregateOperator(exec_ctx, child_operator, Schema{group_by},
+                        {AggregateFunction{AggregateType::SUM, aggregate_column}}) {}
 
-OperatorState AggregateOperator::Next(Chunk &output_chunk) {
-    output_chunk.clear();
+OperatorState AggregateOperator::Next(DataChunk &output_chunk) {
+    output_chunk.Reset(output_schema_.size());
     if (!hash_table_build_) {
         hash_table_build_ = true;
         BuildHashTable();
-        output_ptr_ = hash_table_.begin();
+        output_position_ = 0;
     }
-    while (output_chunk.size() < exec_ctx_.config_.CHUNK_SUGGEST_SIZE) {
-        if (output_ptr_ == hash_table_.end()) {
-            return EXHAUSETED;
-        }
-        output_chunk.emplace_back(Tuple{output_ptr_->first, output_ptr_->second}, INVALID_ID);
-        ++output_ptr_;
+    while (output_position_ == results_.Size() && !spilled_partitions_.empty()) {
+        AggregateSpilledPartition();
+    }
+    auto output_end = std::min(results_.Size(), output_position_ + exec_ctx_.config_.CHUNK_SUGGEST_SIZE);
+    for (; output_position_ < output_end; output_position_++) {
+        output_chunk.Append(results_.GetTuple(output_position_));
+        output_count_++;
     }
-    return HAVE_MORE_OUTPUT;
+    auto exhausted = output_position_ == results_.Size() && spilled_partitions_.empty();
+    // Without group by columns an empty input is one group, but the tables only hold the groups they saw.
+    if (exhausted && group_by_.empty() && output_count_ == 0) {
+        output_chunk.Append(Tuple(aggregates_.size(), 0));
+        output_count_++;
+    }
+    return exhausted ? EXHAUSETED : HAVE_MORE_OUTPUT;
 }
 
 void AggregateOperator::SelfInit() {
-    hash_table_.clear();
+    results_.Reset(output_schema_.size());
     hash_table_build_ = false;
-    output_ptr_ = hash_table_.end();
+    output_position_ = 0;
+    output_count_ = 0;
+    reservation_.Resize(0);
+    spill_.reset();
+    spilled_partitions_.clear();
+    spilled_partition_count_ = 0;
 }
 
 void AggregateOperator::SelfCheck() {
     auto &input_schema = child_operators_[0]->GetOutputSchema();
-    input_schema.GetKeyAttr(group_by_);
-    input_schema.GetKeyAttr(aggregate_column_);
+    for (auto &column_name : group_by_) {
+        input_schema.GetKeyAttr(column_name);
+    }
+    for (auto &aggregate : aggregates_) {
+        if (aggregate.column_name != INVALID_NAME) {
+            input_schema.GetKeyAttr(aggregate.column_name);
+        } else if (aggregate.type != AggregateType::COUNT) {
+            throw std::logic_error("Only COUNT may go without a column");
+        }
+    }
 }
 
-void AggregateOperator::BuildHashTable() {
-    Chunk input_chunk;
-    auto child_state = OperatorState::HAVE_MORE_OUTPUT;
+std::shared_ptr<PartitionedSpill> AggregateOperator::GetSpill(const AggregateTable &table) {
+    std::lock_guard guard(spill_latch_);
+    if (spill_ == nullptr) {
+        spill_ = std::make_shared<PartitionedSpill>(table.SpillColumnCount(), 0, exec_ctx_.config_.SPILL_DIRECTORY);
+    }
+    return spill_;
+}
 
+void AggregateOperator::AddChunk(AggregateTable &table, MemoryReservation &reservation, const DataChunk &chunk) {
+    table.AddChunk(chunk, key_attrs_, input_attrs_);
+    if (!reservation.Resize(table.MemoryUsage())) {
+        table.Spill(*GetSpill(table));
+        reservation.Resize(table.MemoryUsage());
+    }
+}
+
+void AggregateOperator::SpillAll(std::vector<AggregateTable> &tables) {
+    for (auto &table : tables) {
+        table.Spill(*spill_);
+    }
+    spill_->FinishWrite();
+    for (idx_t partition = 0; partition < PartitionedSpill::FANOUT; partition++) {
+        spilled_partitions_.emplace_back(spill_, partition);
+    }
+}
+
+void AggregateOperator::BuildHashTable() {
     auto &input_schema = child_operators_[0]->GetOutputSchema();
-    auto group_by_attr = input_schema.GetKeyAttr(group_by_);
-    auto aggregate_column_attr = input_schema.GetKeyAttr(aggregate_column_);
+    key_attrs_ = input_schema.GetKeyAttrs(group_by_);
+    types_.clear();
+    input_attrs_.clear();
+    for (auto &aggregate : aggregates_) {
+        types_.push_back(aggregate.type);
+        input_attrs_.push_back(aggregate.column_name == INVALID_NAME ? INVALID_ID
+                                                                     : input_schema.GetKeyAttr(aggregate.column_name));
+    }
+    results_.Reset(output_schema_.size());
+
+    // Phase one aggregates into a table per worker, phase two merges the tables. The groups are partitioned,
+    // so a partition of the merged table is a task of its own.
+    auto pipeline = Pipeline::Compile(*child_operators_[0]);
+    if (pipeline) {
+        auto &thread_pool = exec_ctx_.thread_pool_;
+        auto slot_count = Pipeline::SlotCount(thread_pool);
+        idx_t radix_bits = 0;
+        while (radix_bits < MAX_RADIX_BITS && (idx_t(1) << radix_bits) < slot_count * 4) {
+            radix_bits++;
+        }
+        std::vector<AggregateTable> local_tables(slot_count, AggregateTable(group_by_.size(), types_, radix_bits));
+        std::vector<MemoryReservation> reservations;
+        for (idx_t slot = 0; slot < slot_count; slot++) {
+            reservations.emplace_back(exec_ctx_.memory_budget_);
+        }
+        pipeline->Run(thread_pool, [&](idx_t slot, idx_t, DataChunk &chunk) {
+            AddChunk(local_tables[slot], reservations[slot], chunk);
+        });
+        if (spill_ != nullptr) {
+            SpillAll(local_tables);
+            return;
+        }
+        auto table = std::move(local_tables.back());
+        local_tables.pop_back();
+        table.Merge(local_tables, thread_pool);
+        table.Finalize(results_);
+        return;
+    }
 
+    std::vector<AggregateTable> tables{AggregateTable(group_by_.size(), types_, 0)};
+    DataChunk input_chunk;
+    auto child_state = OperatorState::HAVE_MORE_OUTPUT;
     while (child_state != EXHAUSETED) {
         child_state = child_operators_[0]->Next(input_chunk);
-        for (auto &data : input_chunk) {
-            auto &tuple = data.first;
-            auto group_by_key = tuple.KeyFromTuple(group_by_attr);
-            auto aggregate_value = tuple.KeyFromTuple(aggregate_column_attr);
-            auto table_ite = hash_table_.find(group_by_key);
-            if (table_ite == hash_table_.end()) {
-                hash_table_.insert(std::make_pair(group_by_key, aggregate_value));
-            } else {
-                table_ite->second += aggregate_value;
+        AddChunk(tables[0], reservation_, input_chunk);
+    }
+    if (spill_ != nullptr) {
+        SpillAll(tables);
+        return;
+    }
+    tables[0].Finalize(results_);
+}
+
+void AggregateOperator::AggregateSpilledPartition() {
+    auto [spill, partition] = spilled_partitions_.back();
+    spilled_partitions_.pop_back();
+    results_.Reset(output_schema_.size());
+    output_position_ = 0;
+
+    spilled_partition_count_++;
+    AggregateTable table(group_by_.size(), types_, 0);
+    std::shared_ptr<PartitionedSpill> next_spill;
+    DataChunk block;
+    while (spill->Partition(partition).Read(block)) {
+        table.AddStates(block);
+        if (reservation_.Resize(table.MemoryUsage())) {
+            continue;
+        }
+        if (spill->Level() < PartitionedSpill::MAX_LEVEL) {
+            if (next_spill == nullptr) {
+                next_spill = std::make_shared<PartitionedSpill>(table.SpillColumnCount(), spill->Level() + 1,
+                                                                exec_ctx_.config_.SPILL_DIRECTORY);
             }
+            table.Spill(*next_spill);
+            reservation_.Resize(table.MemoryUsage());
+        } else {
+            // A partition of the deepest level is aggregated even if it doesn't fit. The overrun is reserved, so
+            // the other operators of the query spill instead.
+            reservation_.ForceResize(table.MemoryUsage());
         }
     }
+    spill->ReleasePartition(partition);
+    if (next_spill != nullptr) {
+        table.Spill(*next_spill);
+        next_spill->FinishWrite();
+        for (idx_t next_partition = 0; next_partition < PartitionedSpill::FANOUT; next_partition++) {
+            spilled_partitions_.emplace_back(next_spill, next_partition);
+        }
+    } else {
+        table.Finalize(results_);
+    }
+    reservation_.Resize(0);
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,315 @@
+#include "execution/aggregate_table.hpp"
+
+#include "common/hash.hpp"
+#include "common/thread_pool.hpp"
+#include "execution/spill_file.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace babydb {
+
+AggregateTable::AggregateTable(idx_t key_count, const std::vector<AggregateType> &aggregates, idx_t radix_bits)
+    : key_count_(key_count), aggregates_(aggregates), radix_bits_(radix_bits) {
+    for (auto type : aggregates_) {
+        state_offsets_.push_back(state_width_);
+        state_width_ += type == AggregateType::AVG ? 2 : 1;
+    }
+    partitions_.resize(idx_t(1) << radix_bits_);
+    direct_width_ = 1 + state_width_;
+}
+
+void AggregateTable::InitStates(data_t *states) const {
+    for (idx_t i = 0; i < aggregates_.size(); i++) {
+        auto state = states + state_offsets_[i];
+        switch (aggregates_[i]) {
+        case AggregateType::MIN:
+            state[0] = std::numeric_limits<data_t>::max();
+            break;
+        case AggregateType::AVG:
+            state[0] = state[1] = 0;
+            break;
+        default:
+            state[0] = 0;
+        }
+    }
+}
+
+void AggregateTable::CombineStates(data_t *states, const data_t *other) const {
+    for (idx_t i = 0; i < aggregates_.size(); i++) {
+        auto state = states + state_offsets_[i];
+        auto other_state = other + state_offsets_[i];
+        switch (aggregates_[i]) {
+        case AggregateType::MIN:
+            state[0] = std::min(state[0], other_state[0]);
+            break;
+        case AggregateType::MAX:
+            state[0] = std::max(state[0], other_state[0]);
+            break;
+        case AggregateType::AVG:
+            state[1] += other_state[1];
+            [[fallthrough]];
+        default:
+            state[0] += other_state[0];
+        }
+    }
+}
+
+uint64_t AggregateTable::HashKeys(const data_t *keys) const {
+    // Without group keys, everything is one group.
+    if (key_count_ == 0) {
+        return 0;
+    }
+    uint64_t hash = HashKey(keys[0]);
+    for (idx_t i = 1; i < key_count_; i++) {
+        hash = HashKey(keys[i] ^ (hash + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2)));
+    }
+    return hash;
+}
+
+void AggregateTable::Grow(Partition &partition) {
+    idx_t capacity = std::max<idx_t>(16, partition.slots.size() * 2);
+    partition.slots.assign(capacity, INVALID_ID);
+    auto mask = capacity - 1;
+    for (idx_t group = 0; group < partition.group_count; group++) {
+        auto slot = HashKeys(partition.groups.data() + group * GroupWidth()) & mask;
+        while (partition.slots[slot] != INVALID_ID) {
+            slot = (slot + 1) & mask;
+        }
+        partition.slots[slot] = group;
+    }
+}
+
+idx_t AggregateTable::FindOrCreate(Partition &partition, const data_t *keys, uint64_t hash) {
+    // At most half full, the probe sequences stay short.
+    if ((partition.group_count + 1) * 2 > partition.slots.size()) {
+        Grow(partition);
+    }
+    auto mask = partition.slots.size() - 1;
+    auto width = GroupWidth();
+    auto slot = hash & mask;
+    for (; partition.slots[slot] != INVALID_ID; slot = (slot + 1) & mask) {
+        auto group_offset = partition.slots[slot] * width;
+        if (std::equal(keys, keys + key_count_, partition.groups.data() + group_offset)) {
+            return group_offset + key_count_;
+        }
+    }
+    auto group_offset = partition.group_count * width;
+    partition.slots[slot] = partition.group_count++;
+    partition.groups.resize(group_offset + width);
+    std::copy(keys, keys + key_count_, partition.groups.data() + group_offset);
+    InitStates(partition.groups.data() + group_offset + key_count_);
+    return group_offset + key_count_;
+}
+
+idx_t AggregateTable::FindOrCreateDirect(data_t key) {
+    if (key >= DirectSize()) {
+        idx_t size = std::max<idx_t>(64, DirectSize());
+        while (size <= key) {
+            size <<= 1;
+        }
+        direct_.resize(size * direct_width_, 0);
+    }
+    auto offset = key * direct_width_;
+    if (direct_[offset] == 0) {
+        direct_[offset] = 1;
+        InitStates(direct_.data() + offset + 1);
+    }
+    return offset + 1;
+}
+
+void AggregateTable::AddChunk(const DataChunk &chunk, const std::vector<idx_t> &key_attrs,
+                              const std::vector<idx_t> &input_attrs) {
+    auto count = chunk.Size();
+    if (count == 0) {
+        return;
+    }
+    // First every row finds its group, then the aggregates are updated one after another. The group is kept as
+    // the partition and the offset, a group created by a later row may move the array of the partition.
+    const idx_t direct_partition = partitions_.size();
+    std::vector<idx_t> group_partitions(count);
+    std::vector<idx_t> group_offsets(count);
+    std::vector<data_t> keys(key_count_);
+    for (idx_t position = 0; position < count; position++) {
+        auto row = chunk.RowIndex(position);
+        for (idx_t i = 0; i < key_count_; i++) {
+            keys[i] = chunk.Column(key_attrs[i])[row];
+        }
+        if (key_count_ == 1 && keys[0] < DIRECT_LIMIT) {
+            group_partitions[position] = direct_partition;
+            group_offsets[position] = FindOrCreateDirect(keys[0]);
+            continue;
+        }
+        auto hash = HashKeys(keys.data());
+        auto partition = PartitionOf(hash);
+        group_partitions[position] = partition;
+        group_offsets[position] = FindOrCreate(partitions_[partition], keys.data(), hash);
+    }
+    std::vector<data_t*> states(count);
+    for (idx_t position = 0; position < count; position++) {
+        auto partition = group_partitions[position];
+        auto base = partition == direct_partition ? direct_.data() : partitions_[partition].groups.data();
+        states[position] = base + group_offsets[position];
+    }
+
+    for (idx_t i = 0; i < aggregates_.size(); i++) {
+        auto state_offset = state_offsets_[i];
+        if (aggregates_[i] == AggregateType::COUNT) {
+            for (idx_t position = 0; position < count; position++) {
+                states[position][state_offset]++;
+            }
+            continue;
+        }
+        auto &column = chunk.Column(input_attrs[i]);
+        switch (aggregates_[i]) {
+        case AggregateType::SUM:
+            for (idx_t position = 0; position < count; position++) {
+                states[position][state_offset] += column[chunk.RowIndex(position)];
+            }
+            break;
+        case AggregateType::MIN:
+            for (idx_t position = 0; position < count; position++) {
+                auto &state = states[position][state_offset];
+                state = std::min(state, column[chunk.RowIndex(position)]);
+            }
+            break;
+        case AggregateType::MAX:
+            for (idx_t position = 0; position < count; position++) {
+                auto &state = states[position][state_offset];
+                state = std::max(state, column[chunk.RowIndex(position)]);
+            }
+            break;
+        case AggregateType::AVG:
+            for (idx_t position = 0; position < count; position++) {
+                states[position][state_offset] += column[chunk.RowIndex(position)];
+                states[position][state_offset + 1]++;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void AggregateTable::MergePartition(const AggregateTable &other, idx_t partition) {
+    auto &own_partition = partitions_[partition];
+    auto &other_partition = other.partitions_[partition];
+    auto width = GroupWidth();
+    for (idx_t group = 0; group < other_partition.group_count; group++) {
+        auto keys = other_partition.groups.data() + group * width;
+        auto offset = FindOrCreate(own_partition, keys, HashKeys(keys));
+        CombineStates(own_partition.groups.data() + offset, keys + key_count_);
+    }
+}
+
+void AggregateTable::MergeDirect(const AggregateTable &other, idx_t begin, idx_t end) {
+    end = std::min(end, other.DirectSize());
+    for (idx_t key = begin; key < end; key++) {
+        auto offset = key * direct_width_;
+        if (other.direct_[offset] == 0) {
+            continue;
+        }
+        if (direct_[offset] == 0) {
+            direct_[offset] = 1;
+            std::copy(other.direct_.data() + offset + 1, other.direct_.data() + offset + direct_width_,
+                      direct_.data() + offset + 1);
+        } else {
+            CombineStates(direct_.data() + offset + 1, other.direct_.data() + offset + 1);
+        }
+    }
+}
+
+void AggregateTable::Merge(const std::vector<AggregateTable> &others, ThreadPool &thread_pool) {
+    idx_t direct_size = DirectSize();
+    for (auto &other : others) {
+        direct_size = std::max(direct_size, other.DirectSize());
+    }
+    direct_.resize(direct_size * direct_width_, 0);
+
+    // The partitions and the direct ranges are disjoint, no task writes what another one touches.
+    idx_t partition_count = partitions_.size();
+    idx_t direct_tasks = (direct_size + DIRECT_MERGE_RANGE - 1) / DIRECT_MERGE_RANGE;
+    thread_pool.ParallelFor(partition_count + direct_tasks, [&](idx_t task) {
+        for (auto &other : others) {
+            if (task < partition_count) {
+                MergePartition(other, task);
+            } else {
+                auto begin = (task - partition_count) * DIRECT_MERGE_RANGE;
+                MergeDirect(other, begin, begin + DIRECT_MERGE_RANGE);
+            }
+        }
+    });
+}
+
+template <class Function>
+void AggregateTable::ForEachGroup(const Function &function) const {
+    for (data_t key = 0; key < DirectSize(); key++) {
+        auto offset = key * direct_width_;
+        if (direct_[offset] != 0) {
+            function(&key, direct_.data() + offset + 1);
+        }
+    }
+    auto width = GroupWidth();
+    for (auto &partition : partitions_) {
+        for (idx_t group = 0; group < partition.group_count; group++) {
+            auto keys = partition.groups.data() + group * width;
+            function(keys, keys + key_count_);
+        }
+    }
+}
+
+void AggregateTable::Finalize(DataChunk &output) const {
+    Tuple row(key_count_ + aggregates_.size());
+    ForEachGroup([&](const data_t *keys, const data_t *states) {
+        std::copy(keys, keys + key_count_, row.begin());
+        for (idx_t i = 0; i < aggregates_.size(); i++) {
+            auto state = states + state_offsets_[i];
+            row[key_count_ + i] = aggregates_[i] == AggregateType::AVG ? state[0] / state[1] : state[0];
+        }
+        output.Append(row);
+    });
+}
+
+void AggregateTable::Spill(PartitionedSpill &spill) {
+    DataChunk rows;
+    rows.Reset(SpillColumnCount());
+    std::vector<uint64_t> hashes;
+    Tuple row(SpillColumnCount());
+    ForEachGroup([&](const data_t *keys, const data_t *states) {
+        std::copy(keys, keys + key_count_, row.begin());
+        std::copy(states, states + state_width_, row.begin() + key_count_);
+        rows.Append(row);
+        hashes.push_back(HashKeys(keys));
+        if (rows.Size() == SpillFile::BLOCK_ROWS) {
+            spill.Append(rows, hashes);
+            rows.Reset(SpillColumnCount());
+            hashes.clear();
+        }
+    });
+    spill.Append(rows, hashes);
+    partitions_ = std::vector<Partition>(partitions_.size());
+    direct_ = std::vector<data_t>();
+}
+
+void AggregateTable::AddStates(const DataChunk &chunk) {
+    // The keys of a spilled partition are sparse, the direct array would be mostly empty.
+    Tuple row;
+    for (idx_t position = 0; position < chunk.Size(); position++) {
+        row = chunk.GetTuple(position);
+        auto keys = row.data();
+        auto hash = HashKeys(keys);
+        auto &partition = partitions_[PartitionOf(hash)];
+        auto offset = FindOrCreate(partition, keys, hash);
+        CombineStates(partition.groups.data() + offset, keys + key_count_);
+    }
+}
+
+idx_t AggregateTable::MemoryUsage() const {
+    idx_t bytes = direct_.capacity() * sizeof(data_t);
+    for (auto &partition : partitions_) {
+        bytes += partition.groups.capacity() * sizeof(data_t) + partition.slots.capacity() * sizeof(idx_t);
+    }
+    return bytes;
+}
+
+}
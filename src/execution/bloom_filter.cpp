@@ -0,0 +1,18 @@
+#include "execution/bloom_filter.hpp"
+
+namespace babydb {
+
+BloomFilter::BloomFilter(const std::vector<data_t> &keys) {
+    idx_t word_count = 1;
+    while (word_count * 64 < keys.size() * BITS_PER_KEY) {
+        word_count <<= 1;
+    }
+    words_.assign(word_count, 0);
+    word_mask_ = word_count - 1;
+    for (auto key : keys) {
+        auto hash = HashKey(key);
+        words_[hash & word_mask_] |= KeyMask(hash);
+    }
+}
+
+}
@@ -0,0 +1,89 @@
+#include "execution/data_chunk.hpp"
+
+#include <numeric>
+
+namespace babydb {
+
+void DataChunk::Reset(idx_t column_count) {
+    columns_.resize(column_count);
+    for (auto &column : columns_) {
+        column.clear();
+    }
+    handles_.clear();
+    selection_.clear();
+    has_selection_ = false;
+}
+
+Tuple DataChunk::GetTuple(idx_t position) const {
+    auto row = RowIndex(position);
+    Tuple result(columns_.size());
+    for (idx_t column = 0; column < columns_.size(); column++) {
+        result[column] = columns_[column][row];
+    }
+    return result;
+}
+
+Tuple DataChunk::GetTuple(idx_t position, const std::vector<idx_t> &attrs) const {
+    auto row = RowIndex(position);
+    Tuple result(attrs.size());
+    for (idx_t i = 0; i < attrs.size(); i++) {
+        result[i] = columns_[attrs[i]][row];
+    }
+    return result;
+}
+
+void DataChunk::Append(const Tuple &tuple, RowHandle handle) {
+    for (idx_t column = 0; column < columns_.size(); column++) {
+        columns_[column].push_back(tuple[column]);
+    }
+    handles_.push_back(handle);
+}
+
+void DataChunk::Append(std::initializer_list<data_t> values, RowHandle handle) {
+    auto value = values.begin();
+    for (auto &column : columns_) {
+        column.push_back(*value++);
+    }
+    handles_.push_back(handle);
+}
+
+void DataChunk::Append(const Tuple &tuple, const std::vector<idx_t> &attrs, RowHandle handle) {
+    for (idx_t column = 0; column < columns_.size(); column++) {
+        columns_[column].push_back(tuple[attrs[column]]);
+    }
+    handles_.push_back(handle);
+}
+
+void DataChunk::Append(const DataChunk &source) {
+    auto size = source.Size();
+    for (idx_t column = 0; column < columns_.size(); column++) {
+        auto &target = columns_[column];
+        auto &values = source.columns_[column];
+        if (!source.has_selection_) {
+            target.insert(target.end(), values.begin(), values.end());
+            continue;
+        }
+        for (auto row : source.selection_) {
+            target.push_back(values[row]);
+        }
+    }
+    for (idx_t position = 0; position < size; position++) {
+        handles_.push_back(source.GetHandle(position));
+    }
+}
+
+std::vector<idx_t> DataChunk::SelectedRows() const {
+    if (has_selection_) {
+        return selection_;
+    }
+    std::vector<idx_t> result(handles_.size());
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+void DataChunk::Select(std::vector<idx_t> &&selection) {
+    selection_ = std::move(selection);
+    has_selection_ = true;
+}
+
+}
@@ -16,7 +16,7 @@ void DeleteOperator::SelfCheck() {
     throw std::logic_error("Disallowed in Project 2");
 }
 
-OperatorState DeleteOperator::Next(Chunk &output_chunk) {
+OperatorState DeleteOperator::Next(DataChunk &output_chunk) {
     throw std::logic_error("Disallowed in Project 2");
 }
 
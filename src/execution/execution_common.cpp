@@ -1,21 +1,55 @@
 #include "execution/execution_common.hpp"
 
+#include "concurrency/transaction.hpp"
+#include "concurrency/version_link.hpp"
 #include "storage/index.hpp"
 #include "storage/table.hpp"
 
+#include "execution/data_chunk.hpp"
 #include "execution/execution_context.hpp"
 
+#include <algorithm>
+
 namespace babydb {
 
-void InsertRow(WriteTableGuard &write_guard, Tuple &&tuple, Index *index, const data_t &key, ExecutionContext &exec_ctx) {
-    // Project 2: Implement it
-    idx_t rid = write_guard.Rows().size(); // now rowid
-    write_guard.Rows().push_back(Row{std::move(tuple), TupleMeta{}});
-    try {
+void InsertRow(Table &table, WriteTableGuard &write_guard, Tuple &&tuple, Index *index, const data_t &key, ExecutionContext &exec_ctx) {
+    exec_ctx.txn_.CheckWritable();
+    exec_ctx.txn_.BeforeIndexWrite(*index);
+    if (!index->Versioned()) {
+        // The entry is visible right away, so is the row.
+        idx_t rid = write_guard.Rows().size();
+        write_guard.Rows().push_back(Row{std::move(tuple), TupleMeta{}});
         index->InsertEntry(key, rid, exec_ctx);
+        return;
     }
-    catch (TaintedException &e){
-        throw e;
+    bool rewritten;
+    auto rid = exec_ctx.txn_.GetWriteSet().Write(table, key, std::move(tuple), rewritten);
+    // A rewrite only replaces the tuple, the index holds its local row id already.
+    if (!rewritten) {
+        index->InsertEntry(key, rid, exec_ctx);
     }
 }
+
+void UpdateRow(Table &table, Index &index, const RowHandle &handle, Tuple &&tuple, ExecutionContext &exec_ctx) {
+    auto &txn = exec_ctx.txn_;
+    auto row_list = handle.row_list;
+    txn.CheckWritable();
+    txn.BeforeIndexWrite(index);
+    bool rewritten;
+    auto rid = txn.GetWriteSet().Write(table, row_list->key, std::move(tuple), rewritten);
+    if (rewritten) {
+        return;
+    }
+    try {
+        // The tuple was computed from the observed version, a newer one must not be overwritten even if the txn
+        // locked the row since.
+        auto write_ts = std::min(txn.WriteTs(row_list), handle.read_ts);
+        row_list->insert_uncommitted_list(rid, write_ts, txn.txn_id_);
+    } catch (TaintedException &e) {
+        txn.SetConflict(row_list);
+        throw;
+    }
+    txn.AddModifiedRow(row_list);
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "execution/expression/expression.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace babydb {
+
+void ColumnRefExpression::Bind(Schema &columns) {
+    auto iter = std::find(columns.begin(), columns.end(), column_name_);
+    position_ = iter - columns.begin();
+    if (iter == columns.end()) {
+        columns.push_back(column_name_);
+    }
+}
+
+void ColumnRefExpression::Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                                   const std::vector<idx_t> &rows, std::vector<data_t> &output) const {
+    auto &column = chunk.Column(column_map[position_]);
+    output.resize(rows.size());
+    for (idx_t i = 0; i < rows.size(); i++) {
+        output[i] = column[rows[i]];
+    }
+}
+
+BinaryExpression::BinaryExpression(ExpressionType type, std::unique_ptr<Expression> &&left,
+                                   std::unique_ptr<Expression> &&right)
+    : type_(type), left_(std::move(left)), right_(std::move(right)) {
+    if (left_ == nullptr || right_ == nullptr) {
+        throw std::logic_error("BinaryExpression: child expression is nullptr");
+    }
+}
+
+static data_t CheckDivisor(data_t divisor) {
+    if (divisor == 0) {
+        throw std::logic_error("Division by zero");
+    }
+    return divisor;
+}
+
+data_t BinaryExpression::Evaluate(const Tuple &keys) const {
+    auto left = left_->Evaluate(keys);
+    switch (type_) {
+    case ExpressionType::AND:
+        return left != 0 && right_->Evaluate(keys) != 0;
+    case ExpressionType::OR:
+        return left != 0 || right_->Evaluate(keys) != 0;
+    default:
+        break;
+    }
+    auto right = right_->Evaluate(keys);
+    switch (type_) {
+    case ExpressionType::ADD:
+        return left + right;
+    case ExpressionType::SUBTRACT:
+        return left - right;
+    case ExpressionType::MULTIPLY:
+        return left * right;
+    case ExpressionType::DIVIDE:
+        return left / CheckDivisor(right);
+    case ExpressionType::MODULO:
+        return left % CheckDivisor(right);
+    case ExpressionType::EQUAL:
+        return left == right;
+    case ExpressionType::NOT_EQUAL:
+        return left != right;
+    case ExpressionType::LESS:
+        return left < right;
+    case ExpressionType::LESS_EQUAL:
+        return left <= right;
+    case ExpressionType::GREATER:
+        return left > right;
+    case ExpressionType::GREATER_EQUAL:
+        return left >= right;
+    default:
+        throw std::logic_error("BinaryExpression: unknown expression type");
+    }
+}
+
+//! The dispatch on the type is outside of the loop, so the loop body is one inlined operation.
+template <typename Op>
+static void ApplyBinary(std::vector<data_t> &left, const std::vector<data_t> &right, Op op) {
+    for (idx_t i = 0; i < left.size(); i++) {
+        left[i] = op(left[i], right[i]);
+    }
+}
+
+void BinaryExpression::Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                                const std::vector<idx_t> &rows, std::vector<data_t> &output) const {
+    if (type_ == ExpressionType::AND || type_ == ExpressionType::OR) {
+        EvaluateLogic(chunk, column_map, rows, output);
+        return;
+    }
+    left_->Evaluate(chunk, column_map, rows, output);
+    std::vector<data_t> right;
+    right_->Evaluate(chunk, column_map, rows, right);
+    switch (type_) {
+    case ExpressionType::ADD:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a + b; });
+        break;
+    case ExpressionType::SUBTRACT:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a - b; });
+        break;
+    case ExpressionType::MULTIPLY:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a * b; });
+        break;
+    case ExpressionType::DIVIDE:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a / CheckDivisor(b); });
+        break;
+    case ExpressionType::MODULO:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a % CheckDivisor(b); });
+        break;
+    case ExpressionType::EQUAL:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a == b; });
+        break;
+    case ExpressionType::NOT_EQUAL:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a != b; });
+        break;
+    case ExpressionType::LESS:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a < b; });
+        break;
+    case ExpressionType::LESS_EQUAL:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a <= b; });
+        break;
+    case ExpressionType::GREATER:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a > b; });
+        break;
+    case ExpressionType::GREATER_EQUAL:
+        ApplyBinary(output, right, [](data_t a, data_t b) -> data_t { return a >= b; });
+        break;
+    default:
+        throw std::logic_error("BinaryExpression: unknown expression type");
+    }
+}
+
+void BinaryExpression::EvaluateLogic(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                                     const std::vector<idx_t> &rows, std::vector<data_t> &output) const {
+    left_->Evaluate(chunk, column_map, rows, output);
+    // The rows the left side doesn't decide: true ones for AND, false ones for OR.
+    bool undecided_value = type_ == ExpressionType::AND;
+    std::vector<idx_t> undecided_rows;
+    std::vector<idx_t> undecided_positions;
+    for (idx_t i = 0; i < rows.size(); i++) {
+        bool value = output[i] != 0;
+        output[i] = value;
+        if (value == undecided_value) {
+            undecided_rows.push_back(rows[i]);
+            undecided_positions.push_back(i);
+        }
+    }
+    if (undecided_rows.empty()) {
+        return;
+    }
+    std::vector<data_t> right;
+    right_->Evaluate(chunk, column_map, undecided_rows, right);
+    for (idx_t i = 0; i < undecided_positions.size(); i++) {
+        output[undecided_positions[i]] = right[i] != 0;
+    }
+}
+
+void NotExpression::Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                             const std::vector<idx_t> &rows, std::vector<data_t> &output) const {
+    child_->Evaluate(chunk, column_map, rows, output);
+    for (auto &value : output) {
+        value = value == 0;
+    }
+}
+
+void CaseExpression::Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                              const std::vector<idx_t> &rows, std::vector<data_t> &output) const {
+    std::vector<data_t> condition;
+    condition_->Evaluate(chunk, column_map, rows, condition);
+    std::vector<idx_t> branch_rows[2];
+    std::vector<idx_t> branch_positions[2];
+    for (idx_t i = 0; i < rows.size(); i++) {
+        auto branch = condition[i] != 0 ? 1 : 0;
+        branch_rows[branch].push_back(rows[i]);
+        branch_positions[branch].push_back(i);
+    }
+    output.resize(rows.size());
+    std::vector<data_t> values;
+    for (int branch = 0; branch < 2; branch++) {
+        if (branch_rows[branch].empty()) {
+            continue;
+        }
+        auto &expression = branch == 1 ? then_ : otherwise_;
+        expression->Evaluate(chunk, column_map, branch_rows[branch], values);
+        for (idx_t i = 0; i < values.size(); i++) {
+            output[branch_positions[branch][i]] = values[i];
+        }
+    }
+}
+
+}
@@ -2,4 +2,18 @@
 
 namespace babydb {
 
-}
\ No newline at end of file
+void Filter::SelectInternal(const DataChunk &chunk, std::vector<idx_t> &selection) const {
+    idx_t count = 0;
+    for (auto row : selection) {
+        Tuple check_keys;
+        for (auto key_attr : key_attrs_) {
+            check_keys.push_back(chunk.Column(key_attr)[row]);
+        }
+        if (CheckInternal(std::move(check_keys))) {
+            selection[count++] = row;
+        }
+    }
+    selection.resize(count);
+}
+
+}
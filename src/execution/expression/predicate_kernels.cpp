@@ -0,0 +1,167 @@
+#include "execution/expression/predicate_kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace babydb {
+
+//! low <= value <= high is checked as value - low <= high - low, one unsigned comparison.
+struct PreparedRange {
+    const data_t *values;
+
+    data_t low;
+
+    data_t width;
+};
+
+static bool InRanges(const std::vector<PreparedRange> &ranges, idx_t row) {
+    for (auto &range : ranges) {
+        if (range.values[row] - range.low > range.width) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static idx_t SelectDenseScalar(const std::vector<PreparedRange> &ranges, idx_t begin, idx_t count, idx_t *output) {
+    idx_t found = 0;
+    for (idx_t row = begin; row < count; row++) {
+        output[found] = row;
+        found += InRanges(ranges, row);
+    }
+    return found;
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx2")))
+static idx_t SelectDenseAvx2(const std::vector<PreparedRange> &ranges, idx_t count, idx_t *output) {
+    // AVX2 only compares signed 64-bit integers, flipping the sign bits makes it an unsigned comparison.
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    idx_t found = 0;
+    idx_t row = 0;
+    for (; row + 4 <= count; row += 4) {
+        __m256i out_of_range = _mm256_setzero_si256();
+        for (auto &range : ranges) {
+            auto values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(range.values + row));
+            auto offset = _mm256_xor_si256(_mm256_sub_epi64(values, _mm256_set1_epi64x(range.low)), sign);
+            auto width = _mm256_xor_si256(_mm256_set1_epi64x(range.width), sign);
+            out_of_range = _mm256_or_si256(out_of_range, _mm256_cmpgt_epi64(offset, width));
+        }
+        unsigned mask = ~_mm256_movemask_pd(_mm256_castsi256_pd(out_of_range)) & 0xF;
+        while (mask != 0) {
+            output[found++] = row + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    return found + SelectDenseScalar(ranges, row, count, output + found);
+}
+
+__attribute__((target("avx512f")))
+static idx_t SelectDenseAvx512(const std::vector<PreparedRange> &ranges, idx_t count, idx_t *output) {
+    const __m512i lanes = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    idx_t found = 0;
+    idx_t row = 0;
+    for (; row + 8 <= count; row += 8) {
+        __mmask8 mask = 0xFF;
+        for (auto &range : ranges) {
+            auto values = _mm512_loadu_si512(range.values + row);
+            auto offset = _mm512_sub_epi64(values, _mm512_set1_epi64(range.low));
+            mask = _mm512_mask_cmple_epu64_mask(mask, offset, _mm512_set1_epi64(range.width));
+        }
+        auto rows = _mm512_add_epi64(lanes, _mm512_set1_epi64(row));
+        _mm512_mask_compressstoreu_epi64(output + found, mask, rows);
+        found += __builtin_popcount(mask);
+    }
+    return found + SelectDenseScalar(ranges, row, count, output + found);
+}
+
+static SimdLevel DetectSimdLevel() {
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    return SimdLevel::SCALAR;
+}
+
+#else
+
+static SimdLevel DetectSimdLevel() {
+    return SimdLevel::SCALAR;
+}
+
+#endif
+
+static const SimdLevel SUPPORTED_LEVEL = DetectSimdLevel();
+
+static std::atomic<SimdLevel> simd_level{SUPPORTED_LEVEL};
+
+SimdLevel GetSimdLevel() {
+    return simd_level.load(std::memory_order_relaxed);
+}
+
+void SetSimdLevel(SimdLevel level) {
+    simd_level.store(std::min(level, SUPPORTED_LEVEL), std::memory_order_relaxed);
+}
+
+static idx_t SelectDense(const std::vector<PreparedRange> &ranges, idx_t count, idx_t *output) {
+    switch (GetSimdLevel()) {
+#if defined(__x86_64__)
+    case SimdLevel::AVX512:
+        return SelectDenseAvx512(ranges, count, output);
+    case SimdLevel::AVX2:
+        return SelectDenseAvx2(ranges, count, output);
+#endif
+    default:
+        return SelectDenseScalar(ranges, 0, count, output);
+    }
+}
+
+//! Returns false if some range is empty.
+static bool PrepareRanges(const DataChunk &chunk, const std::vector<ColumnRange> &ranges,
+                          std::vector<PreparedRange> &prepared) {
+    for (auto &range : ranges) {
+        if (range.low > range.high) {
+            return false;
+        }
+        prepared.push_back(PreparedRange{chunk.Column(range.column).data(), range.low, range.high - range.low});
+    }
+    return true;
+}
+
+void SelectRanges(const DataChunk &chunk, const std::vector<ColumnRange> &ranges, std::vector<idx_t> &selection) {
+    if (chunk.HasSelection()) {
+        selection = chunk.SelectedRows();
+        NarrowRanges(chunk, ranges, selection);
+        return;
+    }
+    std::vector<PreparedRange> prepared;
+    if (!PrepareRanges(chunk, ranges, prepared)) {
+        selection.clear();
+        return;
+    }
+    selection.resize(chunk.Size());
+    selection.resize(SelectDense(prepared, chunk.Size(), selection.data()));
+}
+
+void NarrowRanges(const DataChunk &chunk, const std::vector<ColumnRange> &ranges, std::vector<idx_t> &selection) {
+    std::vector<PreparedRange> prepared;
+    if (!PrepareRanges(chunk, ranges, prepared)) {
+        selection.clear();
+        return;
+    }
+    idx_t count = 0;
+    for (auto row : selection) {
+        selection[count] = row;
+        count += InRanges(prepared, row);
+    }
+    selection.resize(count);
+}
+
+}
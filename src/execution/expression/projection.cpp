@@ -2,4 +2,30 @@
 
 namespace babydb {
 
-}
\ No newline at end of file
+void Projection::CalcColumn(const DataChunk &chunk, std::vector<data_t> &output) const {
+    output.clear();
+    output.reserve(chunk.Size());
+    for (idx_t position = 0; position < chunk.Size(); position++) {
+        auto row = chunk.RowIndex(position);
+        Tuple check_keys;
+        for (auto key_attr : key_attrs_) {
+            check_keys.push_back(chunk.Column(key_attr)[row]);
+        }
+        output.push_back(CalcInternal(std::move(check_keys)));
+    }
+}
+
+void UnitProjection::CalcColumn(const DataChunk &chunk, std::vector<data_t> &output) const {
+    auto &column = chunk.Column(key_attrs_[0]);
+    if (!chunk.HasSelection()) {
+        output = column;
+        return;
+    }
+    output.clear();
+    output.reserve(chunk.Size());
+    for (idx_t position = 0; position < chunk.Size(); position++) {
+        output.push_back(column[chunk.RowIndex(position)]);
+    }
+}
+
+}
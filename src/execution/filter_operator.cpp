@@ -19,23 +19,41 @@ FilterOperator::FilterOperator(const ExecutionContext &exec_ctx,
     : Operator(exec_ctx, {probe_child_operator}, probe_child_operator->GetOutputSchema()),
       filters_(std::move(filters)) {}
 
-OperatorState FilterOperator::Next(Chunk &output_chunk) {
-    output_chunk.clear();
-    Chunk input_chunk;
-    auto result = child_operators_[0]->Next(input_chunk);
-    for (auto &data : input_chunk) {
-        bool pass_tag = true;
-        for (auto &filter : filters_) {
-            if (!filter->Check(data.first)) {
-                pass_tag = false;
-                break;
-            }
+OperatorState FilterOperator::Next(DataChunk &output_chunk) {
+    auto result = child_operators_[0]->Next(output_chunk);
+    ExecuteChunk(output_chunk);
+    return result;
+}
+
+void FilterOperator::ExecuteChunk(DataChunk &chunk) const {
+    if (chunk.Empty()) {
+        return;
+    }
+    // Only the selection changes, the columns stay where they are.
+    // The column ranges go first, all in one pass of the range kernels.
+    std::vector<ColumnRange> ranges;
+    std::vector<Filter*> other_filters;
+    for (auto &filter : filters_) {
+        ColumnRange range;
+        if (filter->GetColumnRange(range)) {
+            ranges.push_back(range);
+        } else {
+            other_filters.push_back(filter.get());
         }
-        if (pass_tag) {
-            output_chunk.push_back(std::move(data));
+    }
+    std::vector<idx_t> selection;
+    if (ranges.empty()) {
+        selection = chunk.SelectedRows();
+    } else {
+        SelectRanges(chunk, ranges, selection);
+    }
+    for (auto filter : other_filters) {
+        if (selection.empty()) {
+            break;
         }
+        filter->Select(chunk, selection);
     }
-    return result;
+    chunk.Select(std::move(selection));
 }
 
 void FilterOperator::SelfCheck() {
@@ -1,6 +1,13 @@
 #include "execution/hash_join_operator.hpp"
 
 #include "common/config.hpp"
+#include "common/hash.hpp"
+#include "common/thread_pool.hpp"
+#include "execution/pipeline.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 
 namespace babydb {
 
@@ -11,51 +18,124 @@ HashJoinOperator::HashJoinOperator(const ExecutionContext &exec_ctx,
                                    const std::string &build_column_name)
     : Operator(exec_ctx, {probe_child_operator, build_child_operator}),
       probe_column_name_(probe_column_name),
-      build_column_name_(build_column_name) {}
+      build_column_name_(build_column_name),
+      reservation_(exec_ctx.memory_budget_) {}
 
-static Tuple UnionTuple(const Tuple &a, const Tuple &b) {
-    Tuple result = a;
-    result.insert(result.end(), b.begin(), b.end());
+OperatorState HashJoinOperator::Next(DataChunk &output_chunk) {
+    PrepareStreaming();
+    if (probe_exhausted_) {
+        return FinishStreaming(output_chunk) ? HAVE_MORE_OUTPUT : EXHAUSETED;
+    }
+    auto result = child_operators_[0]->Next(output_chunk);
+    ExecuteChunk(output_chunk);
+    if (result == EXHAUSETED) {
+        probe_exhausted_ = true;
+        return probe_spill_ == nullptr ? EXHAUSETED : HAVE_MORE_OUTPUT;
+    }
     return result;
 }
 
-OperatorState HashJoinOperator::Next(Chunk &output_chunk) {
-    output_chunk.clear();
-
+void HashJoinOperator::PrepareStreaming() {
     if (!hash_table_build_) {
         hash_table_build_ = true;
         BuildHashTable();
     }
+}
 
-    auto &probe_child_operator = child_operators_[0];
-    auto probe_key_attr = probe_child_operator->GetOutputSchema().GetKeyAttrs({probe_column_name_})[0];
-    while (output_chunk.size() < exec_ctx_.config_.CHUNK_SUGGEST_SIZE) {
-        if (buffer_ptr_ == buffer_.size() && !probe_child_exhausted_) {
-            if (probe_child_operator->Next(buffer_) == EXHAUSETED) {
-                probe_child_exhausted_ = true;
+void HashJoinOperator::ExecuteChunk(DataChunk &chunk) const {
+    if (probe_spill_ != nullptr && !probing_spilled_) {
+        // The rows of spilled partitions wait on disk for their build rows.
+        auto &keys = chunk.Column(child_operators_[0]->GetOutputSchema().GetKeyAttr(probe_column_name_));
+        std::vector<idx_t> resident_rows;
+        std::vector<idx_t> spilled_rows;
+        std::vector<uint64_t> spilled_hashes;
+        for (idx_t position = 0; position < chunk.Size(); position++) {
+            auto row = chunk.RowIndex(position);
+            auto hash = HashKey(keys[row]);
+            if (resident_partitions_[probe_spill_->PartitionOf(hash)]) {
+                resident_rows.push_back(row);
+            } else {
+                spilled_rows.push_back(row);
+                spilled_hashes.push_back(hash);
             }
-            buffer_ptr_ = 0;
         }
-        if (buffer_ptr_ == buffer_.size()) {
-            return EXHAUSETED;
+        if (!spilled_rows.empty()) {
+            chunk.Select(std::move(spilled_rows));
+            probe_spill_->Append(chunk, spilled_hashes);
+        }
+        chunk.Select(std::move(resident_rows));
+    }
+    ProbeChunk(chunk);
+}
+
+void HashJoinOperator::ProbeChunk(DataChunk &chunk) const {
+    auto probe_key_attr = child_operators_[0]->GetOutputSchema().GetKeyAttr(probe_column_name_);
+    std::vector<idx_t> probe_positions;
+    std::vector<idx_t> build_rows;
+    hash_table_.Probe(chunk, probe_key_attr, probe_positions, build_rows);
+
+    auto probe_columns = chunk.ColumnCount();
+    std::vector<std::vector<data_t>> columns(output_schema_.size());
+    for (idx_t column_id = 0; column_id < probe_columns; column_id++) {
+        auto &input = chunk.Column(column_id);
+        auto &output = columns[column_id];
+        output.reserve(probe_positions.size());
+        for (auto position : probe_positions) {
+            output.push_back(input[chunk.RowIndex(position)]);
+        }
+    }
+    for (idx_t column_id = 0; column_id < build_rows_.ColumnCount(); column_id++) {
+        auto &input = build_rows_.Column(column_id);
+        auto &output = columns[probe_columns + column_id];
+        output.reserve(build_rows.size());
+        for (auto row : build_rows) {
+            output.push_back(input[row]);
         }
+    }
+    chunk.Reset(0);
+    chunk.SetColumns(std::move(columns));
+    for (idx_t i = 0; i < build_rows.size(); i++) {
+        chunk.AppendHandle(RowHandle());
+    }
+}
 
-        auto &probe_tuple = buffer_[buffer_ptr_].first;
-        buffer_ptr_++;
-        auto match_range = hash_table_.equal_range(probe_tuple.KeyFromTuple(probe_key_attr));
-        for (auto match_ite = match_range.first; match_ite != match_range.second; match_ite++) {
-            output_chunk.push_back(std::make_pair(UnionTuple(probe_tuple, match_ite->second), INVALID_ID));
+bool HashJoinOperator::FinishStreaming(DataChunk &chunk) {
+    if (probe_spill_ != nullptr && !probing_spilled_) {
+        probing_spilled_ = true;
+        probe_spill_->FinishWrite();
+    }
+    while (true) {
+        if (current_probe_ != nullptr) {
+            if (current_probe_->Partition(current_partition_).Read(chunk)) {
+                ProbeChunk(chunk);
+                return true;
+            }
+            current_probe_->ReleasePartition(current_partition_);
+            current_probe_.reset();
+        }
+        if (spilled_partitions_.empty()) {
+            chunk.Reset(output_schema_.size());
+            return false;
         }
+        auto spilled = spilled_partitions_.back();
+        spilled_partitions_.pop_back();
+        LoadSpilledPartition(spilled);
     }
-    return HAVE_MORE_OUTPUT;
 }
 
 void HashJoinOperator::SelfInit() {
-    hash_table_.clear();
-    buffer_.clear();
-    buffer_ptr_ = 0;
-    probe_child_exhausted_ = false;
+    hash_table_.Clear();
+    build_rows_.Reset(child_operators_[1]->GetOutputSchema().size());
     hash_table_build_ = false;
+    reservation_.Resize(0);
+    build_spill_.reset();
+    probe_spill_.reset();
+    resident_partitions_.clear();
+    spilled_partitions_.clear();
+    current_probe_.reset();
+    spilled_partition_count_ = 0;
+    probe_exhausted_ = false;
+    probing_spilled_ = false;
 }
 
 void HashJoinOperator::SelfCheck() {
@@ -63,16 +143,154 @@ void HashJoinOperator::SelfCheck() {
     child_operators_[1]->GetOutputSchema().GetKeyAttrs({build_column_name_});
 }
 
+idx_t HashJoinOperator::BuildRowBytes() const {
+    // The row itself, its entry in the partitioned input, its slot and position while the table is built, and
+    // at worst two slots of the at most half full table.
+    return build_rows_.ColumnCount() * sizeof(data_t) + sizeof(RowHandle) + 2 * sizeof(data_t) + 2 * sizeof(idx_t)
+           + 2 * 3 * sizeof(data_t);
+}
+
+//! Whether the distinct build keys fill at most half of the range between the smallest and the largest one.
+//! A density heuristic for pushing a Bloom filter, the probe side has no key statistics: it assumes the probe keys
+//! spread over the build range, where a filter of dense keys passes most of them and only costs its checks.
+static bool SparseBuildKeys(const std::vector<data_t> &build_keys, idx_t key_count) {
+    if (build_keys.empty()) {
+        return true;
+    }
+    auto [min_key, max_key] = std::minmax_element(build_keys.begin(), build_keys.end());
+    return key_count <= (*max_key - *min_key) / 2;
+}
+
 void HashJoinOperator::BuildHashTable() {
     auto &build_child_operator = child_operators_[1];
-    Chunk build_chunk;
-    const idx_t build_key_attr = build_child_operator->GetOutputSchema().GetKeyAttrs({build_column_name_})[0];
-    while (build_child_operator->Next(build_chunk) != EXHAUSETED) {
-        for (auto &chunk_row : build_chunk) {
-            auto &tuple = chunk_row.first;
-            hash_table_.insert(std::make_pair(tuple.KeyFromTuple(build_key_attr), tuple));
+    const idx_t build_key_attr = build_child_operator->GetOutputSchema().GetKeyAttr(build_column_name_);
+    auto &thread_pool = exec_ctx_.thread_pool_;
+    auto &spill_directory = exec_ctx_.config_.SPILL_DIRECTORY;
+    auto row_bytes = BuildRowBytes();
+
+    // The build side runs as a parallel pipeline if it can, and is kept columnar in the order of its morsels.
+    // Once a worker can't reserve its chunk, every later chunk is spilled.
+    std::vector<std::vector<std::pair<idx_t, DataChunk>>> slot_chunks(Pipeline::SlotCount(thread_pool));
+    std::vector<MemoryReservation> reservations;
+    for (idx_t slot = 0; slot < slot_chunks.size(); slot++) {
+        reservations.emplace_back(exec_ctx_.memory_budget_);
+    }
+    std::atomic<bool> spilling{false};
+    std::mutex spill_latch;
+    auto chunk_count = ExecuteStreaming(*build_child_operator, thread_pool,
+                                        [&](idx_t slot, idx_t chunk_id, DataChunk &chunk) {
+        auto &reservation = reservations[slot];
+        if (!spilling.load() && reservation.Resize(reservation.Size() + chunk.Size() * row_bytes)) {
+            slot_chunks[slot].emplace_back(chunk_id, std::move(chunk));
+            return;
+        }
+        spilling.store(true);
+        {
+            std::lock_guard guard(spill_latch);
+            if (build_spill_ == nullptr) {
+                build_spill_ = std::make_shared<PartitionedSpill>(build_rows_.ColumnCount(), 0, spill_directory);
+            }
+        }
+        build_spill_->Append(chunk, build_key_attr);
+    });
+
+    if (build_spill_ == nullptr) {
+        std::vector<DataChunk> build_chunks(chunk_count);
+        for (auto &chunks : slot_chunks) {
+            for (auto &[chunk_id, chunk] : chunks) {
+                build_chunks[chunk_id] = std::move(chunk);
+            }
+        }
+        for (auto &build_chunk : build_chunks) {
+            build_rows_.Append(build_chunk);
+        }
+        reservations.clear();
+        reservation_.Resize(build_rows_.Size() * row_bytes);
+        auto &build_keys = build_rows_.Column(build_key_attr);
+        hash_table_.Build(build_keys, thread_pool);
+        // Sideways information passing: the probe side drops the rows without a match before materializing them.
+        if (SparseBuildKeys(build_keys, hash_table_.KeyCount())) {
+            child_operators_[0]->PushRuntimeFilter(probe_column_name_, std::make_shared<BloomFilter>(build_keys));
+        }
+        return;
+    }
+
+    for (auto &chunks : slot_chunks) {
+        for (auto &[chunk_id, chunk] : chunks) {
+            build_spill_->Append(chunk, build_key_attr);
+        }
+    }
+    slot_chunks.clear();
+    reservations.clear();
+    build_spill_->FinishWrite();
+    probe_spill_ = std::make_shared<PartitionedSpill>(child_operators_[0]->GetOutputSchema().size(), 0,
+                                                      spill_directory);
+    // The partitions that fit are read back and joined while the probe side streams, the others wait.
+    resident_partitions_.assign(PartitionedSpill::FANOUT, false);
+    DataChunk block;
+    for (idx_t partition = 0; partition < PartitionedSpill::FANOUT; partition++) {
+        auto &build_file = build_spill_->Partition(partition);
+        if (!reservation_.Resize(reservation_.Size() + build_file.RowCount() * row_bytes)) {
+            spilled_partitions_.push_back(SpilledPartition{build_spill_, probe_spill_, partition});
+            continue;
+        }
+        while (build_file.Read(block)) {
+            build_rows_.Append(block);
+        }
+        build_spill_->ReleasePartition(partition);
+        resident_partitions_[partition] = true;
+    }
+    hash_table_.Build(build_rows_.Column(build_key_attr), thread_pool);
+}
+
+void HashJoinOperator::LoadSpilledPartition(const SpilledPartition &spilled) {
+    auto build_key_attr = child_operators_[1]->GetOutputSchema().GetKeyAttr(build_column_name_);
+    auto probe_key_attr = child_operators_[0]->GetOutputSchema().GetKeyAttr(probe_column_name_);
+    auto &build_file = spilled.build->Partition(spilled.partition);
+    auto &probe_file = spilled.probe->Partition(spilled.partition);
+    hash_table_.Clear();
+    build_rows_.Reset(build_rows_.ColumnCount());
+    reservation_.Resize(0);
+    if (build_file.RowCount() == 0 || probe_file.RowCount() == 0) {
+        spilled.build->ReleasePartition(spilled.partition);
+        spilled.probe->ReleasePartition(spilled.partition);
+        return;
+    }
+
+    spilled_partition_count_++;
+    DataChunk block;
+    auto build_bytes = build_file.RowCount() * BuildRowBytes();
+    if (!reservation_.Resize(build_bytes) && spilled.build->Level() < PartitionedSpill::MAX_LEVEL) {
+        auto &spill_directory = exec_ctx_.config_.SPILL_DIRECTORY;
+        auto level = spilled.build->Level() + 1;
+        auto build = std::make_shared<PartitionedSpill>(build_rows_.ColumnCount(), level, spill_directory);
+        auto probe = std::make_shared<PartitionedSpill>(child_operators_[0]->GetOutputSchema().size(), level,
+                                                        spill_directory);
+        while (build_file.Read(block)) {
+            build->Append(block, build_key_attr);
+        }
+        while (probe_file.Read(block)) {
+            probe->Append(block, probe_key_attr);
         }
+        spilled.build->ReleasePartition(spilled.partition);
+        spilled.probe->ReleasePartition(spilled.partition);
+        build->FinishWrite();
+        probe->FinishWrite();
+        for (idx_t partition = 0; partition < PartitionedSpill::FANOUT; partition++) {
+            spilled_partitions_.push_back(SpilledPartition{build, probe, partition});
+        }
+        return;
+    }
+    // A partition of the deepest level is joined even if it doesn't fit. The overrun is reserved, so the other
+    // operators of the query spill instead.
+    reservation_.ForceResize(build_bytes);
+    while (build_file.Read(block)) {
+        build_rows_.Append(block);
     }
+    spilled.build->ReleasePartition(spilled.partition);
+    hash_table_.Build(build_rows_.Column(build_key_attr), exec_ctx_.thread_pool_);
+    current_probe_ = spilled.probe;
+    current_partition_ = spilled.partition;
 }
 
-}
\ No newline at end of file
+}
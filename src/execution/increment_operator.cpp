@@ -0,0 +1,84 @@
+#include "execution/increment_operator.hpp"
+
+#include "concurrency/transaction.hpp"
+#include "concurrency/version_link.hpp"
+#include "storage/catalog.hpp"
+#include "storage/index.hpp"
+#include "storage/table.hpp"
+
+namespace babydb {
+
+IncrementOperator::IncrementOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
+                                     const std::string &column_name, int64_t delta,
+                                     const std::optional<EscrowBound> &bound)
+    : Operator(exec_ctx, {child_operator}, Schema{}), table_name_(child_operator->BindTableName()),
+      column_name_(column_name), delta_(delta), bound_(bound) {}
+
+void IncrementOperator::SelfCheck() {
+    auto &table = exec_ctx_.catalog_.FetchTable(table_name_);
+    if (child_operators_[0]->GetOutputSchema().size() != table.schema_.size()) {
+        throw std::logic_error("IncrementOperator: The schema of the table and the input do not match");
+    }
+    table.schema_.GetKeyAttr(column_name_);
+    if (exec_ctx_.catalog_.GetTableIndex(table_name_) == INVALID_NAME) {
+        throw std::logic_error("IncrementOperator: The table has no index");
+    }
+}
+
+OperatorState IncrementOperator::Next(DataChunk &) {
+    auto &table = exec_ctx_.catalog_.FetchTable(table_name_);
+    auto &index = exec_ctx_.catalog_.FetchIndex(exec_ctx_.catalog_.GetTableIndex(table_name_));
+    auto index_key_attr = table.schema_.GetKeyAttr(index.key_name_);
+    auto column = table.schema_.GetKeyAttr(column_name_);
+
+    DataChunk increment_chunk;
+    increment_chunk.Reset(child_operators_[0]->GetOutputSchema().size());
+    DataChunk fetch_chunk;
+    auto child_state = OperatorState::HAVE_MORE_OUTPUT;
+    while (child_state != EXHAUSETED) {
+        child_state = child_operators_[0]->Next(fetch_chunk);
+        increment_chunk.Append(fetch_chunk);
+    }
+
+    auto &txn = exec_ctx_.txn_;
+    txn.CheckWritable();
+    txn.BeforeIndexWrite(index);
+    auto read_guard = table.GetReadTableGuard();
+    auto committed_value = [&read_guard, column](data_t row_id) {
+        return read_guard.Rows()[row_id].tuple_[column];
+    };
+    for (idx_t position = 0; position < increment_chunk.Size(); position++) {
+        auto key = increment_chunk.GetValue(index_key_attr, position);
+        auto row_list = increment_chunk.GetHandle(position).row_list;
+        if (!row_list) {
+            row_list = index.LookupVersions(key);
+        }
+        if (!row_list) {
+            throw std::logic_error("IncrementOperator: The index doesn't keep versions");
+        }
+        bool first = false;
+        try {
+            first = row_list->insert_delta(txn.txn_id_, column, delta_, bound_ ? &*bound_ : nullptr, committed_value);
+        } catch (TaintedException &e) {
+            txn.SetConflict(row_list);
+            throw;
+        }
+        if (first) {
+            // Called in the commit, without any table guard held.
+            txn.AddDeltaRow(row_list, [&table](data_t base_row_id, const std::vector<std::pair<idx_t, int64_t>> &deltas) {
+                auto write_guard = table.GetWriteTableGuard();
+                auto tuple = write_guard.Rows()[base_row_id].tuple_;
+                for (auto &[column, delta] : deltas) {
+                    tuple[column] = static_cast<data_t>(static_cast<int64_t>(tuple[column]) + delta);
+                }
+                data_t row_id = write_guard.Rows().size();
+                write_guard.Rows().push_back(Row{std::move(tuple), TupleMeta{}});
+                return row_id;
+            });
+        }
+    }
+
+    return EXHAUSETED;
+}
+
+}
@@ -1,5 +1,6 @@
 #include "execution/insert_operator.hpp"
 
+#include "concurrency/transaction.hpp"
 #include "execution/execution_common.hpp"
 #include "storage/catalog.hpp"
 #include "storage/index.hpp"
@@ -31,29 +32,32 @@ void InsertOperator::SelfCheck() {
     child_schema.GetKeyAttrs(input_schema_);
 }
 
-OperatorState InsertOperator::Next(Chunk &output_chunk) {
-    output_chunk.clear();
+OperatorState InsertOperator::Next(DataChunk &output_chunk) {
+    output_chunk.Reset(0);
     auto &table = exec_ctx_.catalog_.FetchTable(table_name_);
     auto key_attrs = child_operators_[0]->GetOutputSchema().GetKeyAttrs(input_schema_);
     Index *index = nullptr;
     idx_t index_key_attr = INVALID_ID;
-    if (table.GetIndex() != INVALID_NAME) {
-        index = &exec_ctx_.catalog_.FetchIndex(table.GetIndex());
+    auto index_name = exec_ctx_.catalog_.GetTableIndex(table_name_);
+    if (index_name != INVALID_NAME) {
+        index = &exec_ctx_.catalog_.FetchIndex(index_name);
         index_key_attr = table.schema_.GetKeyAttr(index->key_name_);
     } else {
         throw std::logic_error("Disallowed in Project 2");
     }
 
-    Chunk insert_chunk;
+    DataChunk insert_chunk;
     auto child_state = OperatorState::HAVE_MORE_OUTPUT;
     while (child_state != EXHAUSETED) {
         child_state = child_operators_[0]->Next(insert_chunk);
+        // Admitted before the latch, the admitted writers need it to commit.
+        exec_ctx_.txn_.CheckWritable();
         auto write_guard = table.GetWriteTableGuard();
-        for (auto &insert_data : insert_chunk) {
-            auto insert_tuple = insert_data.first.KeysFromTuple(key_attrs);
+        for (idx_t position = 0; position < insert_chunk.Size(); position++) {
+            auto insert_tuple = insert_chunk.GetTuple(position, key_attrs);
 
             auto key = insert_tuple.KeyFromTuple(index_key_attr);
-            InsertRow(write_guard, std::move(insert_tuple), index, key, exec_ctx_);
+            InsertRow(table, write_guard, std::move(insert_tuple), index, key, exec_ctx_);
         }
     }
     return EXHAUSETED;
@@ -0,0 +1,120 @@
+#include "execution/join_hash_table.hpp"
+
+#include "common/hash.hpp"
+#include "common/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace babydb {
+
+void JoinHashTable::BuildPartition(Partition &partition, const Entry *entries, idx_t count) {
+    // At most half full, the probe sequences stay short.
+    idx_t capacity = 2;
+    while (capacity < count * 2) {
+        capacity <<= 1;
+    }
+    partition.slots.assign(capacity, Slot{0, 0, 0});
+    partition.mask = capacity - 1;
+    partition.key_count = 0;
+    // First every key counts its rows in its slot, then the rows are grouped by the prefix sums of the counts.
+    std::vector<idx_t> entry_slots(count);
+    for (idx_t i = 0; i < count; i++) {
+        auto slot = HashKey(entries[i].key) & partition.mask;
+        while (partition.slots[slot].count != 0 && partition.slots[slot].key != entries[i].key) {
+            slot = (slot + 1) & partition.mask;
+        }
+        partition.key_count += partition.slots[slot].count == 0;
+        partition.slots[slot].key = entries[i].key;
+        partition.slots[slot].count++;
+        entry_slots[i] = slot;
+    }
+    idx_t end = 0;
+    for (auto &slot : partition.slots) {
+        end += slot.count;
+        slot.begin = end;
+    }
+    // Backwards, so the rows of a key stay in row order and begin ends up at the first one.
+    partition.rows.resize(count);
+    for (idx_t i = count; i-- > 0;) {
+        partition.rows[--partition.slots[entry_slots[i]].begin] = entries[i].row;
+    }
+}
+
+void JoinHashTable::Build(const std::vector<data_t> &keys, ThreadPool &thread_pool) {
+    Clear();
+    idx_t row_count = keys.size();
+    while (radix_bits_ < MAX_RADIX_BITS && (row_count >> radix_bits_) > PARTITION_TARGET_ROWS) {
+        radix_bits_++;
+    }
+    idx_t partition_count = idx_t(1) << radix_bits_;
+    partitions_.resize(partition_count);
+
+    // Radix partitioning: every task counts its part of the rows per partition, then scatters them to
+    // the offsets the prefix sums give it, so the entries of a partition stay in row order.
+    idx_t task_count = std::max<idx_t>(1, std::min(thread_pool.ThreadCount() + 1, row_count / PARTITION_TARGET_ROWS));
+    auto task_begin = [row_count, task_count](idx_t task) { return row_count * task / task_count; };
+    std::vector<std::vector<idx_t>> offsets(task_count, std::vector<idx_t>(partition_count, 0));
+    thread_pool.ParallelFor(task_count, [&](idx_t task) {
+        for (idx_t row = task_begin(task); row < task_begin(task + 1); row++) {
+            offsets[task][PartitionOf(HashKey(keys[row]))]++;
+        }
+    });
+    std::vector<idx_t> partition_begin(partition_count + 1, 0);
+    idx_t offset = 0;
+    for (idx_t partition = 0; partition < partition_count; partition++) {
+        partition_begin[partition] = offset;
+        for (idx_t task = 0; task < task_count; task++) {
+            auto count = offsets[task][partition];
+            offsets[task][partition] = offset;
+            offset += count;
+        }
+    }
+    partition_begin[partition_count] = offset;
+
+    std::vector<Entry> entries(row_count);
+    thread_pool.ParallelFor(task_count, [&](idx_t task) {
+        auto &task_offsets = offsets[task];
+        for (idx_t row = task_begin(task); row < task_begin(task + 1); row++) {
+            entries[task_offsets[PartitionOf(HashKey(keys[row]))]++] = Entry{keys[row], row};
+        }
+    });
+    thread_pool.ParallelFor(partition_count, [&](idx_t partition) {
+        BuildPartition(partitions_[partition], entries.data() + partition_begin[partition],
+                       partition_begin[partition + 1] - partition_begin[partition]);
+    });
+}
+
+void JoinHashTable::Probe(const DataChunk &chunk, idx_t key_column, std::vector<idx_t> &probe_positions,
+                          std::vector<idx_t> &build_rows) const {
+    if (partitions_.empty()) {
+        return;
+    }
+    auto &column = chunk.Column(key_column);
+    uint64_t hashes[PROBE_BATCH_SIZE];
+    for (idx_t batch_begin = 0; batch_begin < chunk.Size(); batch_begin += PROBE_BATCH_SIZE) {
+        auto batch_end = std::min(chunk.Size(), batch_begin + PROBE_BATCH_SIZE);
+        // The slots are fetched from memory in parallel, instead of one cache miss after another.
+        for (idx_t position = batch_begin; position < batch_end; position++) {
+            auto hash = HashKey(column[chunk.RowIndex(position)]);
+            hashes[position - batch_begin] = hash;
+            auto &partition = partitions_[PartitionOf(hash)];
+            __builtin_prefetch(&partition.slots[hash & partition.mask]);
+        }
+        for (idx_t position = batch_begin; position < batch_end; position++) {
+            auto key = column[chunk.RowIndex(position)];
+            auto hash = hashes[position - batch_begin];
+            auto &partition = partitions_[PartitionOf(hash)];
+            auto slot = hash & partition.mask;
+            while (partition.slots[slot].count != 0 && partition.slots[slot].key != key) {
+                slot = (slot + 1) & partition.mask;
+            }
+            auto &match = partition.slots[slot];
+            for (auto row = match.begin; row < match.begin + match.count; row++) {
+                probe_positions.push_back(position);
+                build_rows.push_back(partition.rows[row]);
+            }
+        }
+    }
+}
+
+}
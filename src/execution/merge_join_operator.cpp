@@ -0,0 +1,108 @@
+#include "execution/merge_join_operator.hpp"
+
+#include "common/config.hpp"
+
+namespace babydb {
+
+MergeJoinOperator::MergeJoinOperator(const ExecutionContext &exec_ctx,
+                                     const std::shared_ptr<Operator> &left_child_operator,
+                                     const std::shared_ptr<Operator> &right_child_operator,
+                                     const std::string &left_column_name,
+                                     const std::string &right_column_name)
+    : Operator(exec_ctx, {left_child_operator, right_child_operator}),
+      left_column_name_(left_column_name),
+      right_column_name_(right_column_name) {}
+
+void MergeJoinOperator::Fill(Cursor &cursor, Operator &child) {
+    while (cursor.position == cursor.chunk.Size()) {
+        if (cursor.child_state == EXHAUSETED) {
+            cursor.exhausted = true;
+            return;
+        }
+        cursor.child_state = child.Next(cursor.chunk);
+        cursor.position = 0;
+    }
+    auto key = Key(cursor);
+    if (key < cursor.last_key) {
+        throw std::logic_error("The input of a merge join isn't sorted by its key");
+    }
+    cursor.last_key = key;
+}
+
+void MergeJoinOperator::Advance(Cursor &cursor, Operator &child) {
+    cursor.position++;
+    Fill(cursor, child);
+}
+
+OperatorState MergeJoinOperator::Next(DataChunk &output_chunk) {
+    output_chunk.Reset(output_schema_.size());
+    auto &left_child = *child_operators_[0];
+    auto &right_child = *child_operators_[1];
+    if (!started_) {
+        started_ = true;
+        Fill(left_, left_child);
+        Fill(right_, right_child);
+    }
+    while (output_chunk.Size() < exec_ctx_.config_.CHUNK_SUGGEST_SIZE && !left_.exhausted) {
+        if (run_active_) {
+            if (Key(left_) != run_key_) {
+                run_active_ = false;
+                continue;
+            }
+            // Joins the current left row with the rest of the run, the output may end in the middle of it.
+            auto left_row = left_.chunk.GetTuple(left_.position);
+            auto left_columns = left_row.size();
+            for (; run_position_ < run_.Size() && output_chunk.Size() < exec_ctx_.config_.CHUNK_SUGGEST_SIZE;
+                 run_position_++) {
+                left_row.resize(left_columns);
+                auto right_row = run_.GetTuple(run_position_);
+                left_row.insert(left_row.end(), right_row.begin(), right_row.end());
+                output_chunk.Append(left_row);
+            }
+            if (run_position_ == run_.Size()) {
+                run_position_ = 0;
+                Advance(left_, left_child);
+            }
+            continue;
+        }
+        if (right_.exhausted) {
+            break;
+        }
+        auto left_key = Key(left_);
+        auto right_key = Key(right_);
+        if (left_key < right_key) {
+            Advance(left_, left_child);
+        } else if (right_key < left_key) {
+            Advance(right_, right_child);
+        } else {
+            // Buffers the right rows of the key, the left rows of the key may be many.
+            run_.Reset(right_.chunk.ColumnCount());
+            while (!right_.exhausted && Key(right_) == left_key) {
+                run_.Append(right_.chunk.GetTuple(right_.position));
+                Advance(right_, right_child);
+            }
+            run_key_ = left_key;
+            run_active_ = true;
+            run_position_ = 0;
+        }
+    }
+    return left_.exhausted || (right_.exhausted && !run_active_) ? EXHAUSETED : HAVE_MORE_OUTPUT;
+}
+
+void MergeJoinOperator::SelfInit() {
+    left_ = Cursor();
+    right_ = Cursor();
+    left_.key_attr = child_operators_[0]->GetOutputSchema().GetKeyAttr(left_column_name_);
+    right_.key_attr = child_operators_[1]->GetOutputSchema().GetKeyAttr(right_column_name_);
+    run_.Reset(0);
+    run_active_ = false;
+    run_position_ = 0;
+    started_ = false;
+}
+
+void MergeJoinOperator::SelfCheck() {
+    child_operators_[0]->GetOutputSchema().GetKeyAttr(left_column_name_);
+    child_operators_[1]->GetOutputSchema().GetKeyAttr(right_column_name_);
+}
+
+}
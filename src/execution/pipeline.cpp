@@ -0,0 +1,93 @@
+#include "execution/pipeline.hpp"
+
+#include "common/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace babydb {
+
+std::optional<Pipeline> Pipeline::Compile(Operator &root) {
+    std::vector<Operator*> operators;
+    Operator *current = &root;
+    while (current->IsStreaming()) {
+        operators.push_back(current);
+        current = current->GetChildOperator(0);
+    }
+    if (!current->IsMorselSource()) {
+        return std::nullopt;
+    }
+    std::reverse(operators.begin(), operators.end());
+    return Pipeline(*current, std::move(operators));
+}
+
+idx_t Pipeline::SlotCount(const ThreadPool &thread_pool) {
+    return thread_pool.ThreadCount() + 1;
+}
+
+idx_t Pipeline::Run(ThreadPool &thread_pool, const std::function<void(idx_t, idx_t, DataChunk&)> &sink) {
+    for (auto op : operators_) {
+        op->PrepareStreaming();
+    }
+    auto morsel_count = source_->PrepareMorsels();
+    // Every slot keeps claiming morsels, a slot whose worker is busy elsewhere simply claims none.
+    std::atomic<idx_t> next_morsel{0};
+    thread_pool.ParallelFor(std::min(morsel_count, SlotCount(thread_pool)), [&](idx_t slot) {
+        idx_t morsel;
+        while ((morsel = next_morsel.fetch_add(1)) < morsel_count) {
+            DataChunk chunk;
+            source_->ScanMorsel(morsel, chunk);
+            for (auto op : operators_) {
+                op->ExecuteChunk(chunk);
+            }
+            sink(slot, morsel, chunk);
+        }
+    });
+    // The held back output of an operator still goes through the operators above it.
+    idx_t chunk_count = morsel_count;
+    for (idx_t i = 0; i < operators_.size(); i++) {
+        DataChunk chunk;
+        while (operators_[i]->FinishStreaming(chunk)) {
+            for (idx_t j = i + 1; j < operators_.size(); j++) {
+                operators_[j]->ExecuteChunk(chunk);
+            }
+            sink(0, chunk_count++, chunk);
+            chunk = DataChunk();
+        }
+    }
+    return chunk_count;
+}
+
+idx_t ExecuteStreaming(Operator &root, ThreadPool &thread_pool,
+                       const std::function<void(idx_t, idx_t, DataChunk&)> &sink) {
+    auto pipeline = Pipeline::Compile(root);
+    if (pipeline) {
+        return pipeline->Run(thread_pool, sink);
+    }
+    idx_t chunk_count = 0;
+    auto operator_state = OperatorState::HAVE_MORE_OUTPUT;
+    while (operator_state != EXHAUSETED) {
+        DataChunk chunk;
+        operator_state = root.Next(chunk);
+        sink(0, chunk_count++, chunk);
+    }
+    return chunk_count;
+}
+
+std::vector<DataChunk> ExecuteParallel(Operator &root, ThreadPool &thread_pool) {
+    std::vector<DataChunk> results;
+    std::vector<std::vector<std::pair<idx_t, DataChunk>>> slot_results(Pipeline::SlotCount(thread_pool));
+    auto chunk_count = ExecuteStreaming(root, thread_pool,
+                                        [&slot_results](idx_t slot, idx_t chunk_id, DataChunk &chunk) {
+        slot_results[slot].emplace_back(chunk_id, std::move(chunk));
+    });
+    results.resize(chunk_count);
+    for (auto &slot_result : slot_results) {
+        for (auto &[chunk_id, chunk] : slot_result) {
+            results[chunk_id] = std::move(chunk);
+        }
+    }
+    return results;
+}
+
+}
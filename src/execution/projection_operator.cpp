@@ -36,6 +36,7 @@ ProjectionOperator::ProjectionOperator(const ExecutionContext &exec_ctx,
         }
     } else {
         projections_ = std::move(projections);
+        output_schema_.clear();
         for (auto &projection_function : projections_) {
             output_schema_.push_back(projection_function->output_name_);
         }
@@ -48,17 +49,39 @@ ProjectionOperator::ProjectionOperator(const ExecutionContext &exec_ctx,
                                        bool update_in_place)
     : ProjectionOperator(exec_ctx, child_operator, TransToVec(std::move(projection)), update_in_place) {}
 
-OperatorState ProjectionOperator::Next(Chunk &output_chunk) {
+OperatorState ProjectionOperator::Next(DataChunk &output_chunk) {
     auto result = child_operators_[0]->Next(output_chunk);
-    for (auto &data : output_chunk) {
-        auto &old_tuple = data.first;
-        Tuple new_tuple;
-        for (auto &projection_function : projections_) {
-            new_tuple.push_back(projection_function->Calc(old_tuple));
+    ExecuteChunk(output_chunk);
+    return result;
+}
+
+void ProjectionOperator::ExecuteChunk(DataChunk &chunk) const {
+    // Every output column is calculated from the whole input chunk at once, compacting its selection.
+    std::vector<std::vector<data_t>> columns(projections_.size());
+    for (idx_t column_id = 0; column_id < projections_.size(); column_id++) {
+        projections_[column_id]->Calc(chunk, columns[column_id]);
+    }
+    std::vector<RowHandle> handles;
+    for (idx_t position = 0; position < chunk.Size(); position++) {
+        handles.push_back(chunk.GetHandle(position));
+    }
+    chunk.Reset(0);
+    chunk.SetColumns(std::move(columns));
+    for (auto &handle : handles) {
+        chunk.AppendHandle(handle);
+    }
+}
+
+bool ProjectionOperator::PushRuntimeFilter(const std::string &column_name,
+                                           const std::shared_ptr<const BloomFilter> &filter) {
+    for (auto &projection_function : projections_) {
+        if (projection_function->output_name_ != column_name) {
+            continue;
         }
-        old_tuple = new_tuple;
+        auto input_column = projection_function->PassThroughColumn();
+        return input_column != INVALID_NAME && child_operators_[0]->PushRuntimeFilter(input_column, filter);
     }
-    return result;
+    return false;
 }
 
 void ProjectionOperator::SelfInit() {
@@ -1,9 +1,13 @@
 #include "execution/range_index_scan_operator.hpp"
 
+#include "concurrency/transaction.hpp"
+#include "concurrency/version_link.hpp"
 #include "storage/catalog.hpp"
 #include "storage/index.hpp"
 #include "storage/table.hpp"
 
+#include <algorithm>
+
 namespace babydb {
 
 RangeIndexScanOperator::RangeIndexScanOperator(const ExecutionContext &exec_ctx, const std::string &table_name,
@@ -12,41 +16,81 @@ RangeIndexScanOperator::RangeIndexScanOperator(const ExecutionContext &exec_ctx,
     : Operator(exec_ctx, {}, output_schema), table_name_(table_name), fetch_columns_(fetch_columns),
       index_name_(index_name), range_(range) {}
 
-OperatorState RangeIndexScanOperator::Next(Chunk &output_chunk) {
-    output_chunk.clear();
+OperatorState RangeIndexScanOperator::Next(DataChunk &output_chunk) {
+    ScanRows();
+    auto end = std::min<idx_t>(row_ids_.size(), next_row_ + exec_ctx_.config_.CHUNK_SUGGEST_SIZE);
+    ReadRows(next_row_, end, output_chunk);
+    next_row_ = end;
+    return next_row_ == row_ids_.size() ? EXHAUSETED : HAVE_MORE_OUTPUT;
+}
 
-    auto &table = exec_ctx_.catalog_.FetchTable(table_name_);
-    auto key_attrs = table.schema_.GetKeyAttrs(fetch_columns_);
-    auto read_guard = table.GetReadTableGuard();
+idx_t RangeIndexScanOperator::PrepareMorsels() {
+    ScanRows();
+    auto morsel_size = exec_ctx_.config_.MORSEL_SIZE;
+    return (row_ids_.size() + morsel_size - 1) / morsel_size;
+}
 
-    if (!results_scanned_) {
-        results_scanned_ = true;
+void RangeIndexScanOperator::ScanMorsel(idx_t morsel, DataChunk &output_chunk) const {
+    auto morsel_size = exec_ctx_.config_.MORSEL_SIZE;
+    ReadRows(morsel * morsel_size, std::min<idx_t>(row_ids_.size(), (morsel + 1) * morsel_size), output_chunk);
+}
 
-        auto &index = dynamic_cast<RangeIndex&>(exec_ctx_.catalog_.FetchIndex(index_name_));
-        index.ScanRange(range_, row_ids_, exec_ctx_);
-        next_ite_ = row_ids_.begin();
+void RangeIndexScanOperator::ScanRows() {
+    if (results_scanned_) {
+        return;
     }
+    results_scanned_ = true;
 
-    while (output_chunk.size() < exec_ctx_.config_.CHUNK_SUGGEST_SIZE) {
-        if (next_ite_ == row_ids_.end()) {
-            return EXHAUSETED;
-        }
+    auto &table = exec_ctx_.catalog_.FetchTable(table_name_);
+    auto &index = dynamic_cast<RangeIndex&>(exec_ctx_.catalog_.FetchIndex(index_name_));
+    {
+        auto read_guard = table.GetReadTableGuard();
+        index.ScanRangeWithVersions(range_, row_ids_, row_lists_, exec_ctx_);
+    }
+    // A lock holder takes the table latch to commit, so the locks are waited for without it.
+    if (exec_ctx_.txn_.LocksRows(table)) {
+        LockRows();
+    }
+    next_row_ = 0;
+}
 
-        auto row_id = *next_ite_;
-        next_ite_++;
+void RangeIndexScanOperator::ReadRows(idx_t begin, idx_t end, DataChunk &output_chunk) const {
+    output_chunk.Reset(output_schema_.size());
 
-        auto& [tuple, meta] = read_guard.Rows()[row_id];
-        output_chunk.emplace_back(tuple.KeysFromTuple(key_attrs), row_id);
-    }
+    auto &table = exec_ctx_.catalog_.FetchTable(table_name_);
+    auto key_attrs = table.schema_.GetKeyAttrs(fetch_columns_);
+    auto read_guard = table.GetReadTableGuard();
 
-    return HAVE_MORE_OUTPUT;
+    for (idx_t i = begin; i < end; i++) {
+        auto row_id = row_ids_[i];
+        auto row_list = row_lists_.empty() ? nullptr : row_lists_[i];
 
+        // The txn's own new tuples are not in the table yet.
+        auto &tuple = WriteSet::IsLocalRow(row_id) ? exec_ctx_.txn_.GetWriteSet().LocalTuple(row_id)
+                                                   : read_guard.Rows()[row_id].tuple_;
+        if (PassesRuntimeFilters(tuple, key_attrs)) {
+            auto read_ts = row_read_ts_.empty() ? exec_ctx_.txn_.read_ts_ : row_read_ts_[i];
+            output_chunk.Append(tuple, key_attrs, RowHandle(row_id, row_list, read_ts));
+        }
+    }
+}
+
+void RangeIndexScanOperator::LockRows() {
+    auto &txn = exec_ctx_.txn_;
+    auto mode = for_update_ ? LockMode::EXCLUSIVE : LockMode::SHARED;
+    row_read_ts_.resize(row_lists_.size());
+    for (idx_t i = 0; i < row_lists_.size(); i++) {
+        row_read_ts_[i] = txn.LockRow(row_lists_[i], mode);
+        row_ids_[i] = row_lists_[i]->search_list(row_read_ts_[i], txn.txn_id_);
+    }
 }
 
 void RangeIndexScanOperator::SelfInit() {
     row_ids_.clear();
+    row_lists_.clear();
+    row_read_ts_.clear();
     results_scanned_ = false;
-    next_ite_ = row_ids_.end();
+    next_row_ = 0;
 }
 
 void RangeIndexScanOperator::SelfCheck() {
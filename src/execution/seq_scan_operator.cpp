@@ -35,22 +35,22 @@ SeqScanOperator::SeqScanOperator(const ExecutionContext &exec_ctx, const std::st
     throw std::logic_error("Disallowed in Project 2");
 }
 
-OperatorState SeqScanOperator::Next(Chunk &output_chunk) {
-    output_chunk.clear();
+OperatorState SeqScanOperator::Next(DataChunk &output_chunk) {
+    output_chunk.Reset(output_schema_.size());
 
     auto &table = exec_ctx_.catalog_.FetchTable(table_name_);
     auto key_attrs = table.schema_.GetKeyAttrs(fetch_columns_);
 
     auto read_guard = table.GetReadTableGuard();
 
-    while (output_chunk.size() < exec_ctx_.config_.CHUNK_SUGGEST_SIZE) {
+    while (output_chunk.Size() < exec_ctx_.config_.CHUNK_SUGGEST_SIZE) {
         if (next_row_id >= read_guard.Rows().size()) {
             return EXHAUSETED;
         }
         auto& [tuple, meta] = read_guard.Rows()[next_row_id];
         next_row_id++;
 
-        output_chunk.emplace_back(tuple.KeysFromTuple(key_attrs), next_row_id - 1);
+        output_chunk.Append(tuple, key_attrs, next_row_id - 1);
     }
 
     return HAVE_MORE_OUTPUT;
@@ -0,0 +1,287 @@
+#include "execution/sort_operator.hpp"
+
+#include "common/config.hpp"
+#include "execution/pipeline.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace babydb {
+
+/**
+ * Run Merger
+ * Merges sorted runs with a loser tree: the leaves are the heads of the runs, every inner node keeps the loser of
+ * the match below it, and the overall winner is kept apart. Replacing the winner with the next row of its run
+ * replays only the matches on the path of its leaf, log(runs) comparisons per row.
+ */
+class RunMerger {
+public:
+    RunMerger(std::vector<std::unique_ptr<SpillFile>> &&runs, const std::vector<idx_t> &sort_attrs,
+              const std::vector<SortKey> &sort_keys)
+        : runs_(std::move(runs)), sort_attrs_(sort_attrs), sort_keys_(sort_keys), cursors_(runs_.size()) {
+        for (idx_t run = 0; run < runs_.size(); run++) {
+            cursors_[run].exhausted = !runs_[run]->Read(cursors_[run].block);
+        }
+        BuildTree();
+    }
+    //! Appends up to count rows in order to chunk.
+    void Next(DataChunk &chunk, idx_t count) {
+        for (idx_t i = 0; i < count && !Exhausted(); i++) {
+            auto winner = tree_[0];
+            auto &cursor = cursors_[winner];
+            chunk.Append(cursor.block.GetTuple(cursor.position));
+            if (++cursor.position == cursor.block.Size()) {
+                cursor.position = 0;
+                cursor.exhausted = !runs_[winner]->Read(cursor.block);
+            }
+            Replay(winner);
+        }
+    }
+
+    bool Exhausted() const {
+        return runs_.empty() || cursors_[tree_[0]].exhausted;
+    }
+
+private:
+    struct Cursor {
+        DataChunk block;
+
+        idx_t position{0};
+
+        bool exhausted{false};
+    };
+    //! An exhausted run loses every match, equal keys go to the earlier run.
+    bool Less(idx_t left, idx_t right) const {
+        auto &left_cursor = cursors_[left];
+        auto &right_cursor = cursors_[right];
+        if (left_cursor.exhausted || right_cursor.exhausted) {
+            return !left_cursor.exhausted;
+        }
+        for (idx_t i = 0; i < sort_attrs_.size(); i++) {
+            auto left_key = NormalizeSortKey(left_cursor.block.GetValue(sort_attrs_[i], left_cursor.position),
+                                             sort_keys_[i].descending);
+            auto right_key = NormalizeSortKey(right_cursor.block.GetValue(sort_attrs_[i], right_cursor.position),
+                                              sort_keys_[i].descending);
+            if (left_key != right_key) {
+                return left_key < right_key;
+            }
+        }
+        return left < right;
+    }
+    //! The leaf of run i is node runs + i, node n has the children 2n and 2n + 1.
+    void BuildTree() {
+        idx_t run_count = runs_.size();
+        tree_.assign(std::max<idx_t>(run_count, 1), 0);
+        std::vector<idx_t> winners(run_count, 0);
+        auto winner_of = [&](idx_t node) { return node >= run_count ? node - run_count : winners[node]; };
+        for (idx_t node = run_count; node-- > 1;) {
+            auto left = winner_of(2 * node);
+            auto right = winner_of(2 * node + 1);
+            if (Less(right, left)) {
+                std::swap(left, right);
+            }
+            winners[node] = left;
+            tree_[node] = right;
+        }
+        tree_[0] = run_count > 1 ? winners[1] : 0;
+    }
+
+    void Replay(idx_t run) {
+        auto winner = run;
+        for (auto node = (run + runs_.size()) / 2; node >= 1; node /= 2) {
+            if (Less(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+private:
+    std::vector<std::unique_ptr<SpillFile>> runs_;
+
+    const std::vector<idx_t> &sort_attrs_;
+
+    const std::vector<SortKey> &sort_keys_;
+
+    std::vector<Cursor> cursors_;
+    //! tree_[0] is the winner, the other nodes keep losers.
+    std::vector<idx_t> tree_;
+};
+
+//! A stable LSD radix sort of the pairs by their keys, a byte at a time.
+static void RadixSort(std::vector<std::pair<data_t, idx_t>> &pairs, std::vector<std::pair<data_t, idx_t>> &buffer) {
+    constexpr idx_t BYTES = sizeof(data_t);
+    std::vector<idx_t> counts(BYTES * 256, 0);
+    for (auto &pair : pairs) {
+        for (idx_t byte = 0; byte < BYTES; byte++) {
+            counts[byte * 256 + ((pair.first >> (byte * 8)) & 0xff)]++;
+        }
+    }
+    buffer.resize(pairs.size());
+    for (idx_t byte = 0; byte < BYTES; byte++) {
+        auto byte_counts = counts.data() + byte * 256;
+        // All keys share the byte, the pass would keep the order.
+        if (std::find(byte_counts, byte_counts + 256, pairs.size()) != byte_counts + 256) {
+            continue;
+        }
+        idx_t offset = 0;
+        for (idx_t digit = 0; digit < 256; digit++) {
+            auto count = byte_counts[digit];
+            byte_counts[digit] = offset;
+            offset += count;
+        }
+        for (auto &pair : pairs) {
+            buffer[byte_counts[(pair.first >> (byte * 8)) & 0xff]++] = pair;
+        }
+        pairs.swap(buffer);
+    }
+}
+
+SortOperator::SortOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
+                           const std::vector<SortKey> &sort_keys)
+    : Operator(exec_ctx, {child_operator}), sort_keys_(sort_keys), reservation_(exec_ctx.memory_budget_) {}
+
+SortOperator::~SortOperator() = default;
+
+OperatorState SortOperator::Next(DataChunk &output_chunk) {
+    output_chunk.Reset(output_schema_.size());
+    if (!input_sorted_) {
+        input_sorted_ = true;
+        SortInput();
+    }
+    auto suggest_size = exec_ctx_.config_.CHUNK_SUGGEST_SIZE;
+    if (merger_ != nullptr) {
+        merger_->Next(output_chunk, suggest_size);
+        return merger_->Exhausted() ? EXHAUSETED : HAVE_MORE_OUTPUT;
+    }
+    auto output_end = std::min<idx_t>(sorted_rows_.size(), output_position_ + suggest_size);
+    for (; output_position_ < output_end; output_position_++) {
+        auto row = sorted_rows_[output_position_];
+        output_chunk.Append(rows_.GetTuple(row), rows_.GetHandle(row));
+    }
+    return output_position_ == sorted_rows_.size() ? EXHAUSETED : HAVE_MORE_OUTPUT;
+}
+
+void SortOperator::SelfInit() {
+    rows_.Reset(output_schema_.size());
+    sorted_rows_.clear();
+    output_position_ = 0;
+    reservation_.Resize(0);
+    runs_.clear();
+    merger_.reset();
+    input_sorted_ = false;
+}
+
+void SortOperator::SelfCheck() {
+    if (sort_keys_.empty()) {
+        throw std::logic_error("Sort without keys");
+    }
+    for (auto &sort_key : sort_keys_) {
+        output_schema_.GetKeyAttr(sort_key.column_name);
+    }
+}
+
+idx_t SortOperator::RowBytes() const {
+    // The row, its place in sorted_rows_, and the key pairs of the radix sort.
+    return output_schema_.size() * sizeof(data_t) + sizeof(RowHandle) + sizeof(idx_t) + 4 * sizeof(data_t);
+}
+
+void SortOperator::SortInput() {
+    sort_attrs_.clear();
+    for (auto &sort_key : sort_keys_) {
+        sort_attrs_.push_back(output_schema_.GetKeyAttr(sort_key.column_name));
+    }
+    std::mutex latch;
+    ExecuteStreaming(*child_operators_[0], exec_ctx_.thread_pool_, [&](idx_t, idx_t, DataChunk &chunk) {
+        std::lock_guard guard(latch);
+        rows_.Append(chunk);
+        if (!reservation_.Resize(rows_.Size() * RowBytes())) {
+            SpillRun();
+        }
+    });
+    if (runs_.empty()) {
+        SortRows();
+        return;
+    }
+    if (!rows_.Empty()) {
+        SpillRun();
+    }
+    MergeRuns();
+}
+
+void SortOperator::SortRows() {
+    sorted_rows_.resize(rows_.Size());
+    for (idx_t row = 0; row < rows_.Size(); row++) {
+        sorted_rows_[row] = row;
+    }
+    // Stable passes from the last key to the first leave the rows ordered by all keys.
+    std::vector<std::pair<data_t, idx_t>> pairs(rows_.Size());
+    std::vector<std::pair<data_t, idx_t>> buffer;
+    for (idx_t i = sort_attrs_.size(); i-- > 0;) {
+        auto &column = rows_.Column(sort_attrs_[i]);
+        for (idx_t position = 0; position < pairs.size(); position++) {
+            auto row = sorted_rows_[position];
+            pairs[position] = {NormalizeSortKey(column[row], sort_keys_[i].descending), row};
+        }
+        RadixSort(pairs, buffer);
+        for (idx_t position = 0; position < pairs.size(); position++) {
+            sorted_rows_[position] = pairs[position].second;
+        }
+    }
+}
+
+void SortOperator::SpillRun() {
+    SortRows();
+    auto run = std::make_unique<SpillFile>(output_schema_.size(), exec_ctx_.config_.SPILL_DIRECTORY);
+    DataChunk block;
+    block.Reset(output_schema_.size());
+    for (auto row : sorted_rows_) {
+        block.Append(rows_.GetTuple(row));
+        if (block.Size() == SpillFile::BLOCK_ROWS) {
+            run->Append(block);
+            block.Reset(output_schema_.size());
+        }
+    }
+    run->Append(block);
+    run->FinishWrite();
+    runs_.push_back(std::move(run));
+    rows_.Reset(output_schema_.size());
+    sorted_rows_.clear();
+    reservation_.Resize(0);
+}
+
+void SortOperator::MergeRuns() {
+    // A run being merged holds one block in memory.
+    idx_t fan_in = runs_.size();
+    auto &budget = exec_ctx_.memory_budget_;
+    if (budget != nullptr && budget->Limit() != 0) {
+        auto block_bytes = SpillFile::BLOCK_ROWS * output_schema_.size() * sizeof(data_t);
+        fan_in = std::max<idx_t>(2, budget->Limit() / block_bytes);
+    }
+    // Every pass merges neighbouring runs, so equal keys still go to the earlier run.
+    while (runs_.size() > fan_in) {
+        std::vector<std::unique_ptr<SpillFile>> merged_runs;
+        for (idx_t begin = 0; begin < runs_.size(); begin += fan_in) {
+            auto end = std::min(runs_.size(), begin + fan_in);
+            std::vector<std::unique_ptr<SpillFile>> group;
+            for (auto run = begin; run < end; run++) {
+                group.push_back(std::move(runs_[run]));
+            }
+            RunMerger merger(std::move(group), sort_attrs_, sort_keys_);
+            auto merged_run = std::make_unique<SpillFile>(output_schema_.size(), exec_ctx_.config_.SPILL_DIRECTORY);
+            DataChunk block;
+            while (!merger.Exhausted()) {
+                block.Reset(output_schema_.size());
+                merger.Next(block, SpillFile::BLOCK_ROWS);
+                merged_run->Append(block);
+            }
+            merged_run->FinishWrite();
+            merged_runs.push_back(std::move(merged_run));
+        }
+        runs_ = std::move(merged_runs);
+    }
+    merger_ = std::make_unique<RunMerger>(std::move(runs_), sort_attrs_, sort_keys_);
+    runs_.clear();
+}
+
+}
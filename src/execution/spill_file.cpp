@@ -0,0 +1,134 @@
+#include "execution/spill_file.hpp"
+
+#include "common/hash.hpp"
+
+#include <filesystem>
+#include <unistd.h>
+
+namespace babydb {
+
+SpillFile::SpillFile(idx_t column_count, const std::string &directory)
+    : column_count_(column_count), directory_(directory) {
+    buffer_.Reset(column_count_);
+}
+
+SpillFile::~SpillFile() {
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+}
+
+void SpillFile::Append(const DataChunk &chunk) {
+    row_count_ += chunk.Size();
+    for (idx_t position = 0; position < chunk.Size(); position++) {
+        auto row = chunk.RowIndex(position);
+        for (idx_t column = 0; column < column_count_; column++) {
+            buffer_.Column(column).push_back(chunk.Column(column)[row]);
+        }
+        buffer_.AppendHandle(RowHandle());
+        if (buffer_.Size() == BLOCK_ROWS) {
+            Flush();
+        }
+    }
+}
+
+void SpillFile::Flush() {
+    if (buffer_.Empty()) {
+        return;
+    }
+    if (file_ == nullptr) {
+        auto directory = directory_.empty() ? std::filesystem::temp_directory_path().string() : directory_;
+        auto path = directory + "/babydb_spill_XXXXXX";
+        int fd = mkstemp(path.data());
+        if (fd < 0) {
+            throw std::runtime_error("Cannot create a spill file in " + directory);
+        }
+        unlink(path.c_str());
+        file_ = fdopen(fd, "w+b");
+        if (file_ == nullptr) {
+            close(fd);
+            throw std::runtime_error("Cannot create a spill file in " + directory);
+        }
+    }
+    idx_t size = buffer_.Size();
+    bool written = std::fwrite(&size, sizeof(size), 1, file_) == 1;
+    for (idx_t column = 0; column < column_count_; column++) {
+        written &= std::fwrite(buffer_.Column(column).data(), sizeof(data_t), size, file_) == size;
+    }
+    if (!written) {
+        throw std::runtime_error("Cannot write a spill file");
+    }
+    buffer_.Reset(column_count_);
+}
+
+void SpillFile::FinishWrite() {
+    Flush();
+    if (file_ != nullptr) {
+        std::rewind(file_);
+    }
+}
+
+bool SpillFile::Read(DataChunk &chunk) {
+    chunk.Reset(column_count_);
+    idx_t size;
+    if (file_ == nullptr || std::fread(&size, sizeof(size), 1, file_) != 1) {
+        return false;
+    }
+    for (idx_t column = 0; column < column_count_; column++) {
+        auto &values = chunk.Column(column);
+        values.resize(size);
+        if (std::fread(values.data(), sizeof(data_t), size, file_) != size) {
+            throw std::runtime_error("Cannot read a spill file");
+        }
+    }
+    for (idx_t row = 0; row < size; row++) {
+        chunk.AppendHandle(RowHandle());
+    }
+    return true;
+}
+
+PartitionedSpill::PartitionedSpill(idx_t column_count, idx_t level, const std::string &directory)
+    : column_count_(column_count), level_(level) {
+    for (idx_t partition = 0; partition < FANOUT; partition++) {
+        partitions_.push_back(std::make_unique<SpillFile>(column_count_, directory));
+    }
+}
+
+idx_t PartitionedSpill::PartitionOf(uint64_t hash) const {
+    return HashKey(hash ^ (0x9e3779b97f4a7c15ULL * (level_ + 1))) >> (64 - FANOUT_BITS);
+}
+
+void PartitionedSpill::Append(const DataChunk &chunk, const std::vector<uint64_t> &hashes) {
+    std::vector<std::vector<idx_t>> selections(FANOUT);
+    for (idx_t position = 0; position < chunk.Size(); position++) {
+        selections[PartitionOf(hashes[position])].push_back(position);
+    }
+    // Positions of the selection are rows of a chunk without one.
+    DataChunk rows;
+    rows.Reset(column_count_);
+    rows.Append(chunk);
+    std::lock_guard guard(latch_);
+    for (idx_t partition = 0; partition < FANOUT; partition++) {
+        if (!selections[partition].empty()) {
+            rows.Select(std::move(selections[partition]));
+            partitions_[partition]->Append(rows);
+        }
+    }
+}
+
+void PartitionedSpill::Append(const DataChunk &chunk, idx_t key_attr) {
+    std::vector<uint64_t> hashes(chunk.Size());
+    auto &keys = chunk.Column(key_attr);
+    for (idx_t position = 0; position < chunk.Size(); position++) {
+        hashes[position] = HashKey(keys[chunk.RowIndex(position)]);
+    }
+    Append(chunk, hashes);
+}
+
+void PartitionedSpill::FinishWrite() {
+    for (auto &partition : partitions_) {
+        partition->FinishWrite();
+    }
+}
+
+}
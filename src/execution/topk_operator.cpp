@@ -0,0 +1,96 @@
+#include "execution/topk_operator.hpp"
+
+#include "common/config.hpp"
+#include "common/thread_pool.hpp"
+#include "execution/pipeline.hpp"
+
+#include <algorithm>
+
+namespace babydb {
+
+void TopKOperator::Heap::AddChunk(const DataChunk &chunk, const std::vector<idx_t> &sort_attrs,
+                                  const std::vector<SortKey> &sort_keys) {
+    if (limit_ == 0) {
+        return;
+    }
+    keys_.resize(sort_attrs.size());
+    for (idx_t position = 0; position < chunk.Size(); position++) {
+        for (idx_t i = 0; i < sort_attrs.size(); i++) {
+            keys_[i] = NormalizeSortKey(chunk.GetValue(sort_attrs[i], position), sort_keys[i].descending);
+        }
+        // Most rows of a large input lose against the top without being materialized.
+        if (entries_.size() == limit_ && !(keys_ < entries_.front().keys)) {
+            continue;
+        }
+        Push(Entry{keys_, chunk.GetTuple(position)});
+    }
+}
+
+void TopKOperator::Heap::Push(Entry &&entry) {
+    if (entries_.size() == limit_) {
+        if (!Less(entry, entries_.front())) {
+            return;
+        }
+        std::pop_heap(entries_.begin(), entries_.end(), Less);
+        entries_.back() = std::move(entry);
+    } else {
+        entries_.push_back(std::move(entry));
+    }
+    std::push_heap(entries_.begin(), entries_.end(), Less);
+}
+
+std::vector<TopKOperator::Entry> TopKOperator::Heap::TakeSorted() {
+    std::sort_heap(entries_.begin(), entries_.end(), Less);
+    return std::move(entries_);
+}
+
+TopKOperator::TopKOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
+                           const std::vector<SortKey> &sort_keys, idx_t limit)
+    : Operator(exec_ctx, {child_operator}), sort_keys_(sort_keys), limit_(limit) {}
+
+OperatorState TopKOperator::Next(DataChunk &output_chunk) {
+    output_chunk.Reset(output_schema_.size());
+    if (!heap_build_) {
+        heap_build_ = true;
+        BuildHeap();
+    }
+    auto output_end = std::min<idx_t>(results_.size(), output_position_ + exec_ctx_.config_.CHUNK_SUGGEST_SIZE);
+    for (; output_position_ < output_end; output_position_++) {
+        output_chunk.Append(results_[output_position_].row);
+    }
+    return output_position_ == results_.size() ? EXHAUSETED : HAVE_MORE_OUTPUT;
+}
+
+void TopKOperator::SelfInit() {
+    results_.clear();
+    output_position_ = 0;
+    heap_build_ = false;
+}
+
+void TopKOperator::SelfCheck() {
+    if (sort_keys_.empty()) {
+        throw std::logic_error("TopK without sort keys");
+    }
+    for (auto &sort_key : sort_keys_) {
+        output_schema_.GetKeyAttr(sort_key.column_name);
+    }
+}
+
+void TopKOperator::BuildHeap() {
+    std::vector<idx_t> sort_attrs;
+    for (auto &sort_key : sort_keys_) {
+        sort_attrs.push_back(output_schema_.GetKeyAttr(sort_key.column_name));
+    }
+    std::vector<Heap> heaps(Pipeline::SlotCount(exec_ctx_.thread_pool_), Heap(limit_));
+    ExecuteStreaming(*child_operators_[0], exec_ctx_.thread_pool_, [&](idx_t slot, idx_t, DataChunk &chunk) {
+        heaps[slot].AddChunk(chunk, sort_attrs, sort_keys_);
+    });
+    for (idx_t slot = 1; slot < heaps.size(); slot++) {
+        for (auto &entry : heaps[slot].TakeSorted()) {
+            heaps[0].Push(std::move(entry));
+        }
+    }
+    results_ = heaps[0].TakeSorted();
+}
+
+}
@@ -1,6 +1,8 @@
 #include "execution/update_operator.hpp"
 
 #include "common/macro.hpp"
+#include "concurrency/transaction.hpp"
+#include "concurrency/version_link.hpp"
 #include "execution/execution_common.hpp"
 #include "storage/catalog.hpp"
 #include "storage/index.hpp"
@@ -10,12 +12,16 @@ namespace babydb {
 
 UpdateOperator::UpdateOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator)
     : Operator(exec_ctx, {child_operator}, Schema{}), table_name_(child_operator->BindTableName()),
-      input_schema_(std::nullopt) {}
+      input_schema_(std::nullopt) {
+    child_operator->BindForUpdate();
+}
 
 UpdateOperator::UpdateOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
                                const Schema &input_schema)
     : Operator(exec_ctx, {child_operator}, Schema{}), table_name_(child_operator->BindTableName()),
-      input_schema_(input_schema) {}
+      input_schema_(input_schema) {
+    child_operator->BindForUpdate();
+}
 
 void UpdateOperator::SelfCheck() {
     auto &child_schema = child_operators_[0]->GetOutputSchema();
@@ -33,7 +39,7 @@ void UpdateOperator::SelfCheck() {
     }
 }
 
-OperatorState UpdateOperator::Next(Chunk &) {
+OperatorState UpdateOperator::Next(DataChunk &) {
     auto &table = exec_ctx_.catalog_.FetchTable(table_name_);
     std::vector<idx_t> key_attrs;
     if (input_schema_.has_value()) {
@@ -42,27 +48,71 @@ OperatorState UpdateOperator::Next(Chunk &) {
 
     Index *index = nullptr;
     idx_t index_key_attr = INVALID_ID;
-    if (table.GetIndex() != INVALID_NAME) {
-        index = &exec_ctx_.catalog_.FetchIndex(table.GetIndex());
+    auto index_name = exec_ctx_.catalog_.GetTableIndex(table_name_);
+    if (index_name != INVALID_NAME) {
+        index = &exec_ctx_.catalog_.FetchIndex(index_name);
         index_key_attr = table.schema_.GetKeyAttr(index->key_name_);
     } else {
         throw std::logic_error("Disallowed in Project 2");
     }
 
-    Chunk update_chunk;
+    DataChunk update_chunk;
+    update_chunk.Reset(child_operators_[0]->GetOutputSchema().size());
 
-    Chunk fetch_chunk;
+    DataChunk fetch_chunk;
     auto child_state = OperatorState::HAVE_MORE_OUTPUT;
     while (child_state != EXHAUSETED) {
         child_state = child_operators_[0]->Next(fetch_chunk);
-        update_chunk.insert(update_chunk.end(), fetch_chunk.begin(), fetch_chunk.end());
+        update_chunk.Append(fetch_chunk);
+    }
+
+    auto &txn = exec_ctx_.txn_;
+    bool row_locking = txn.LocksRows(table);
+    // Rows scanned with their version lists are claimed directly, the others go through the index.
+    // The row storage takes whole tuples, so the written rows are materialized here.
+    std::vector<Tuple> insert_tuples;
+    for (idx_t position = 0; position < update_chunk.Size(); position++) {
+        auto &handle = update_chunk.GetHandle(position);
+        auto row_list = handle.row_list;
+        if (row_list && row_list->key == update_chunk.GetValue(index_key_attr, position)) {
+            if (row_locking) {
+                txn.LockRow(row_list, LockMode::EXCLUSIVE);
+            }
+            txn.BeforeWrite(row_list);
+            UpdateRow(table, *index, handle, update_chunk.GetTuple(position), exec_ctx_);
+        } else {
+            insert_tuples.push_back(update_chunk.GetTuple(position));
+        }
+    }
+    if (insert_tuples.empty()) {
+        return EXHAUSETED;
+    }
+
+    // Wait for the holders of the rows before blocking all writers of the table with its latch.
+    if (txn.WaitsForWriters() || row_locking) {
+        std::vector<VersionSkipList*> row_lists;
+        {
+            auto read_guard = table.GetReadTableGuard();
+            for (auto &tuple : insert_tuples) {
+                row_lists.push_back(index->LookupVersions(tuple.KeyFromTuple(index_key_attr)));
+            }
+        }
+        for (auto row_list : row_lists) {
+            if (row_list && row_locking) {
+                txn.LockRow(row_list, LockMode::EXCLUSIVE);
+            }
+            if (row_list) {
+                txn.BeforeWrite(row_list);
+            }
+        }
     }
 
     // Directly cover (since in Project 2, there are no primary key update)
+    txn.CheckWritable();
     auto write_guard = table.GetWriteTableGuard();
-    for (auto &data : update_chunk) {
-        auto key = data.first.KeyFromTuple(index_key_attr);
-        InsertRow(write_guard, std::move(data.first), index, key, exec_ctx_);
+    for (auto &tuple : insert_tuples) {
+        auto key = tuple.KeyFromTuple(index_key_attr);
+        InsertRow(table, write_guard, std::move(tuple), index, key, exec_ctx_);
     }
 
     return EXHAUSETED;
@@ -1,5 +1,9 @@
 #include "execution/value_operator.hpp"
 
+#include "common/config.hpp"
+
+#include <algorithm>
+
 namespace babydb {
 
 ValueOperator::ValueOperator(const ExecutionContext &execute_context, const Schema &output_schema, std::vector<Tuple> &&tuples)
@@ -17,16 +21,34 @@ void ValueOperator::SelfCheck() {
     }
 }
 
-OperatorState ValueOperator::Next(Chunk &output_chunk) {
-    output_chunk.clear();
-    while (output_chunk.size() < exec_ctx_.config_.CHUNK_SUGGEST_SIZE) {
+OperatorState ValueOperator::Next(DataChunk &output_chunk) {
+    output_chunk.Reset(output_schema_.size());
+    while (output_chunk.Size() < exec_ctx_.config_.CHUNK_SUGGEST_SIZE) {
         if (next_tuple_id == tuples_.size()) {
             return EXHAUSETED;
         }
-        output_chunk.emplace_back(tuples_[next_tuple_id], INVALID_ID);
+        if (PassesRuntimeFilters(tuples_[next_tuple_id])) {
+            output_chunk.Append(tuples_[next_tuple_id]);
+        }
         next_tuple_id++;
     }
     return HAVE_MORE_OUTPUT;
 }
 
+idx_t ValueOperator::PrepareMorsels() {
+    auto morsel_size = exec_ctx_.config_.MORSEL_SIZE;
+    return (tuples_.size() + morsel_size - 1) / morsel_size;
+}
+
+void ValueOperator::ScanMorsel(idx_t morsel, DataChunk &output_chunk) const {
+    output_chunk.Reset(output_schema_.size());
+    auto morsel_size = exec_ctx_.config_.MORSEL_SIZE;
+    auto end = std::min<idx_t>(tuples_.size(), (morsel + 1) * morsel_size);
+    for (idx_t tuple_id = morsel * morsel_size; tuple_id < end; tuple_id++) {
+        if (PassesRuntimeFilters(tuples_[tuple_id])) {
+            output_chunk.Append(tuples_[tuple_id]);
+        }
+    }
+}
+
 }
\ No newline at end of file
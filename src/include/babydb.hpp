@@ -6,14 +6,20 @@
 #include "common/types.hpp"
 #include "concurrency/transaction.hpp"
 #include "execution/execution_context.hpp"
+#include "execution/memory_budget.hpp"
 
+#include <atomic>
+#include <map>
 #include <memory>
-#include <shared_mutex>
+#include <mutex>
+#include <set>
 
 namespace babydb {
 
 class Catalog;
 struct ConfigGroup;
+class Index;
+class ThreadPool;
 class TransactionManager;
 class Transaction;
 
@@ -34,33 +40,74 @@ public:
                      IndexType index_type);
 
     void DropIndex(const std::string &index_name);
+    //! Every transaction locks the rows of the table, for tables with a few hot rows. Not used under OCC.
+    void SetRowLocking(const std::string &table_name, bool row_locking);
 
-    std::shared_ptr<Transaction> CreateTxn();
+    //! With row_locking, the txn locks the rows it reads and writes, and waits instead of failing on write conflicts.
+    std::shared_ptr<Transaction> CreateTxn(bool row_locking = false);
+    //! A new attempt of an aborted transaction. It keeps the age of the first attempt for the contention policies,
+    //! so a transaction that keeps losing does not restart as the youngest one every time.
+    std::shared_ptr<Transaction> RestartTxn(const Transaction &aborted);
+    //! A read-only transaction reading the database as it was at a commit ts. Only the history kept by
+    //! ConfigGroup::HISTORY_RETENTION or by a named snapshot can be read.
+    std::shared_ptr<Transaction> CreateTxnAsOf(idx_t commit_ts);
+
+    std::shared_ptr<Transaction> CreateTxnAsOf(const std::string &snapshot_name);
+    //! Names the current state of the database and keeps it readable until dropped. Returns its commit ts.
+    idx_t CreateSnapshot(const std::string &snapshot_name);
+
+    void DropSnapshot(const std::string &snapshot_name);
 
     bool Commit(Transaction &txn);
+    //! The current cap on running write transactions (see ConfigGroup::MAX_WRITE_TXNS), 0 if there is none.
+    idx_t GetAdmissionLimit();
 
     void Abort(Transaction &txn);
 
-    const Catalog& GetCatalog() {
-        return *catalog_;
-    }
+    //! The newest catalog version. A transaction uses the version it started with.
+    std::shared_ptr<const Catalog> GetCatalog() const;
 
     const ConfigGroup& GetConfig() {
         return *config_;
     }
 
+    //! Every context has a memory budget of its own, the operators of a query should share one context.
     ExecutionContext GetExecutionContext(const std::shared_ptr<Transaction> &txn) {
-        return ExecutionContext{*txn, GetCatalog(), GetConfig()};
+        return ExecutionContext{*txn, txn->GetCatalog(), GetConfig(), *thread_pool_,
+                                std::make_shared<MemoryBudget>(GetConfig().QUERY_MEMORY_LIMIT)};
     }
 
 private:
-    std::unique_ptr<Catalog> catalog_;
+    //! A copy of the newest catalog version, one per shard of threads.
+    struct alignas(64) CatalogShard {
+        std::mutex latch;
+
+        std::shared_ptr<const Catalog> catalog;
+    };
+
+    CatalogShard& LocalCatalogShard() const;
+    //! Replaces the catalog in every shard. DDL serialized by ddl_latch_ publishes a changed clone.
+    void Publish(std::shared_ptr<const Catalog> catalog);
+
+private:
+    static const idx_t CATALOG_SHARD_COUNT = 16;
+    //! Beginning a transaction only latches the shard of the calling thread.
+    mutable CatalogShard catalog_shards_[CATALOG_SHARD_COUNT];
+
+    mutable std::atomic<idx_t> next_catalog_shard_{0};
 
     std::unique_ptr<TransactionManager> txn_mgr_;
 
     std::unique_ptr<ConfigGroup> config_;
 
-    std::shared_mutex db_lock_;
+    std::unique_ptr<ThreadPool> thread_pool_;
+
+    std::mutex ddl_latch_;
+    //! The last dropped index of each table. The transactions that wrote through it before the drop may still
+    //! append rows, the next index of the table waits for them.
+    std::map<std::string, std::weak_ptr<Index>> dropped_indexes_;
+    //! Tables an index is built for without the ddl_latch_.
+    std::set<std::string> indexing_tables_;
 };
 
 }
\ No newline at end of file
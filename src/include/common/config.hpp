@@ -7,6 +7,25 @@ namespace babydb {
 struct ConfigGroup {
     idx_t CHUNK_SUGGEST_SIZE = 128;
     IsolationLevel ISOLATION_LEVEL = IsolationLevel::SNAPSHOT;
+    //! OCC ignores ISOLATION_LEVEL.
+    ConcurrencyControlType CONCURRENCY_CONTROL = ConcurrencyControlType::MVCC;
+    //! Worker threads used by parallel index scans, index builds and pipelines. 0 means one per extra hardware thread.
+    idx_t WORKER_THREADS = 0;
+    //! Rows of a morsel, the unit of work a parallel pipeline hands out to a worker.
+    idx_t MORSEL_SIZE = 4096;
+    //! Bytes the hash tables of a query may hold before they spill partitions to disk. 0 means no limit.
+    idx_t QUERY_MEMORY_LIMIT = 0;
+    //! Where spilled partitions go, the system temp directory if empty.
+    std::string SPILL_DIRECTORY = "";
+    //! Period of the background version garbage collector. 0 disables the background thread.
+    idx_t GC_INTERVAL_MS = 5;
+    ContentionPolicy CONTENTION_POLICY = ContentionPolicy::NO_WAIT;
+    //! Upper bound of a single wait or backoff of the contention policy.
+    idx_t MAX_CONTENTION_WAIT_US = 2000;
+    //! The garbage collector keeps what the last HISTORY_RETENTION commit timestamps read, for AS OF transactions.
+    idx_t HISTORY_RETENTION = 0;
+    //! Upper bound of the adaptive cap on running write transactions. 0 admits every writer at once.
+    idx_t MAX_WRITE_TXNS = 0;
 };
 
 }
\ No newline at end of file
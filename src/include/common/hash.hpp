@@ -0,0 +1,18 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+
+namespace babydb {
+
+//! The finalizer of MurmurHash3, every bit of the key affects the high and the low bits of the hash.
+inline uint64_t HashKey(data_t key) {
+    uint64_t hash = key;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+}
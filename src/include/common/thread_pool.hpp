@@ -0,0 +1,71 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace babydb {
+
+/**
+ * Thread Pool
+ * A fixed set of worker threads owned by one database instance.
+ * The thread calling ParallelFor also executes tasks while it waits, so ParallelFor can be nested
+ * (a task may call ParallelFor again) without exhausting the workers.
+ * Every worker has its own job deque. A job scheduled by a worker goes to its own deque, which it pops from the
+ * back, so nested work stays on the core that produced it. An idle worker steals from the front of the others.
+ */
+class ThreadPool {
+public:
+    //! thread_count = 0 creates no worker, and every ParallelFor runs in the calling thread.
+    explicit ThreadPool(idx_t thread_count);
+
+    ~ThreadPool();
+
+    DISALLOW_COPY_AND_MOVE(ThreadPool);
+
+    //! Number of worker threads, not counting the calling thread.
+    idx_t ThreadCount() const {
+        return workers_.size();
+    }
+    //! Runs body(0), ..., body(task_count - 1) and returns when all of them are finished.
+    //! Tasks are started in index order. The first exception thrown by a task is rethrown here.
+    void ParallelFor(idx_t task_count, const std::function<void(idx_t)> &body);
+
+private:
+    void Schedule(std::function<void()> &&job);
+
+    void WorkerLoop(idx_t worker_id);
+    //! Pops the own deque, then steals from the others.
+    std::function<void()> TakeJob(idx_t worker_id);
+
+private:
+    struct JobQueue {
+        std::mutex latch;
+
+        std::deque<std::function<void()>> jobs;
+    };
+
+    std::vector<std::thread> workers_;
+
+    std::vector<std::unique_ptr<JobQueue>> queues_;
+    //! Jobs scheduled but not taken yet, guarded by latch_ for the sleeping workers.
+    idx_t pending_jobs_{0};
+    //! Queue of the next job scheduled from outside of the pool.
+    std::atomic<idx_t> next_queue_{0};
+
+    std::mutex latch_;
+
+    std::condition_variable cv_;
+
+    bool stop_{false};
+};
+
+}
@@ -22,6 +22,12 @@ typedef uint64_t idx_t;
 
 const idx_t TXN_START_ID = 1ll << 62;
 
+//! The range a counter column must stay in, even if only the pending decrements (or increments) commit.
+struct EscrowBound {
+    data_t min = DATA_MIN;
+    data_t max = DATA_MAX;
+};
+
 struct RangeInfo {
     data_t start;
     data_t end;
@@ -94,4 +100,22 @@ enum class IsolationLevel : uint8_t {
     SERIALIZABLE
 };
 
+//! The protocol behind the TransactionManager.
+enum class ConcurrencyControlType : uint8_t {
+    //! Snapshot reads, first-writer-wins, and SSI for SERIALIZABLE.
+    MVCC,
+    //! Snapshot reads validated at commit, always serializable.
+    OCC
+};
+
+//! What a writer does when another running transaction holds the row it wants to write.
+enum class ContentionPolicy : uint8_t {
+    //! Abort at once (TaintedException).
+    NO_WAIT,
+    //! An older transaction waits for a younger holder, a younger one aborts and waits before its retry.
+    WAIT_DIE,
+    //! Abort at once, then back off longer the more conflicts the row had.
+    BACKOFF
+};
+
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <atomic>
+#include <map>
+
+namespace babydb {
+
+/**
+ * Active Transaction Registry
+ * Read timestamps of the running transactions, sharded by thread so that beginning a transaction
+ * only touches the shard of the calling thread. Each shard publishes its smallest read ts,
+ * and the watermark is the minimum over the shards and the last commit ts.
+ */
+class ActiveTxnRegistry {
+public:
+    ActiveTxnRegistry() = default;
+
+    DISALLOW_COPY_AND_MOVE(ActiveTxnRegistry);
+
+    //! Registers a reader of the current `last_commit_ts` and returns (read ts, shard id).
+    std::pair<idx_t, idx_t> Register(const std::atomic<idx_t> &last_commit_ts);
+    //! Registers a reader of an older ts and returns the shard id. The caller checks that ts is still readable.
+    idx_t RegisterAt(idx_t read_ts);
+
+    void Unregister(idx_t shard_id, idx_t read_ts);
+    //! No running transaction, nor one registering concurrently, reads below the result.
+    idx_t Watermark(const std::atomic<idx_t> &last_commit_ts) const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic_flag latch = ATOMIC_FLAG_INIT;
+        //! read ts -> number of running transactions.
+        std::map<idx_t, idx_t> read_ts_count;
+        //! Smallest registered read ts, INVALID_ID if none.
+        std::atomic<idx_t> min_read_ts{INVALID_ID};
+
+        void Lock();
+
+        void Unlock() {
+            latch.clear(std::memory_order_release);
+        }
+
+        void PublishMin() {
+            min_read_ts.store(read_ts_count.empty() ? INVALID_ID : read_ts_count.begin()->first);
+        }
+    };
+
+    Shard& LocalShard(idx_t &shard_id);
+
+    static const idx_t SHARD_COUNT = 64;
+
+    Shard shards_[SHARD_COUNT];
+
+    std::atomic<idx_t> next_shard_{0};
+};
+
+}
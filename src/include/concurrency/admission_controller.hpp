@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace babydb {
+
+/**
+ * Admission Controller
+ * Caps the number of running write transactions, so that an overloaded database doesn't spend its time
+ * on retries of aborted transactions. A transaction is admitted at its first write and waits in a queue
+ * while the cap is reached. The cap adapts AIMD style: every commit raises it by 1 / cap, an abort halves it,
+ * at most once per cap finished writers.
+ */
+class AdmissionController {
+public:
+    //! max_limit = 0 disables it.
+    explicit AdmissionController(idx_t max_limit);
+
+    DISALLOW_COPY_AND_MOVE(AdmissionController);
+
+    bool Enabled() const {
+        return max_limit_ != 0;
+    }
+    //! Waits for a free slot if `wait`, otherwise takes one over the cap.
+    void Acquire(bool wait);
+
+    void Release(bool committed);
+    //! The current cap, 0 if disabled.
+    idx_t GetLimit();
+
+private:
+    static constexpr double MIN_LIMIT = 1;
+
+    const idx_t max_limit_;
+
+    double limit_;
+
+    idx_t running_{0};
+    //! Writers finished since the last decrease.
+    idx_t finished_since_decrease_{0};
+
+    std::mutex latch_;
+
+    std::condition_variable cv_;
+};
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "common/config.hpp"
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <functional>
+#include <memory>
+
+namespace babydb {
+
+class GarbageCollector;
+class SsiPredicateLocks;
+class Transaction;
+class VersionSkipList;
+
+/**
+ * Concurrency Control
+ * The protocol specific part of the TransactionManager: what a transaction tracks while it runs and
+ * whether it may commit. Versions, timestamps and installing the writes are shared by all protocols.
+ * The hooks are only called for transactions that Begin attached to the protocol.
+ */
+class ConcurrencyControl {
+public:
+    virtual ~ConcurrencyControl() = default;
+
+    static std::unique_ptr<ConcurrencyControl> Create(const ConfigGroup &config, const GarbageCollector &gc);
+    //! Sets up the protocol state of a new read-write transaction.
+    virtual void Begin(Transaction &txn) = 0;
+
+    virtual void OnRead(Transaction &txn, VersionSkipList *row_list) {}
+
+    virtual void OnRangeRead(Transaction &txn, SsiPredicateLocks &locks, const RangeInfo &range) {}
+
+    virtual void OnWrite(Transaction &txn, VersionSkipList *row_list) {}
+
+    virtual void OnInsert(Transaction &txn, SsiPredicateLocks &locks, data_t key) {}
+    //! Sets the commit ts of the txn and returns true if it may commit. A failed check may have taken a ts
+    //! from allocate_ts already, the TransactionManager then publishes it without versions.
+    virtual bool PreCommit(Transaction &txn, const std::function<idx_t()> &allocate_ts) = 0;
+    //! Called when the txn committed or aborted.
+    virtual void Finish(Transaction &txn, bool committed) {}
+};
+
+}
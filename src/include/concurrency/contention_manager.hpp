@@ -0,0 +1,86 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+
+namespace babydb {
+
+class Transaction;
+class VersionSkipList;
+
+/**
+ * Contention Manager
+ * Lets writers wait for the holder of a row instead of retrying in a hot loop. Waiters sleep in
+ * striped queues keyed by the row and are woken when the holder commits or rolls back. Every row
+ * counts its recent write conflicts, and the backoff grows with that count.
+ */
+class ContentionManager {
+public:
+    ContentionManager(ContentionPolicy policy, idx_t max_wait_us);
+
+    DISALLOW_COPY_AND_MOVE(ContentionManager);
+
+    bool Enabled() const {
+        return policy_ != ContentionPolicy::NO_WAIT;
+    }
+    //! Called before txn claims row_list. An older txn waits (bounded) for a younger holder under WAIT_DIE.
+    void BeforeWrite(const Transaction &txn, VersionSkipList *row_list);
+    //! Called when txn aborts after losing row_list, before the caller retries.
+    void AfterConflict(const Transaction &txn, VersionSkipList *row_list);
+    //! The uncommitted version of row_list was installed or rolled back.
+    void Release(VersionSkipList *row_list);
+    //! Called when txn starts and after its rows are released. Only retries are remembered, a holder found
+    //! by its txn id is as old as the id otherwise.
+    void Register(const Transaction &txn);
+
+    void Unregister(const Transaction &txn);
+
+private:
+    struct alignas(64) Stripe {
+        std::mutex latch;
+
+        std::condition_variable cv;
+
+        std::atomic<idx_t> waiters{0};
+    };
+
+    //! Restarted txns by txn id, with their priority.
+    struct alignas(64) PriorityShard {
+        std::mutex latch;
+
+        std::unordered_map<idx_t, idx_t> priorities;
+    };
+
+    Stripe& StripeOf(VersionSkipList *row_list);
+
+    PriorityShard& ShardOf(idx_t txn_id);
+    //! The priority of the txn holding an uncommitted version.
+    idx_t PriorityOf(idx_t txn_id);
+    //! Returns true if row_list is free (or owned by txn_id) before the deadline.
+    bool WaitRelease(VersionSkipList *row_list, idx_t txn_id, std::chrono::steady_clock::time_point deadline);
+
+private:
+    static const idx_t STRIPE_COUNT = 256;
+
+    static const idx_t MIN_BACKOFF_US = 20;
+
+    static const idx_t PRIORITY_SHARD_COUNT = 16;
+
+    const ContentionPolicy policy_;
+
+    const std::chrono::microseconds max_wait_;
+
+    Stripe stripes_[STRIPE_COUNT];
+
+    PriorityShard priority_shards_[PRIORITY_SHARD_COUNT];
+    //! Running retries, the lookup is skipped while there are none.
+    std::atomic<idx_t> restarted_txns_{0};
+};
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace babydb {
+
+/**
+ * Epoch Manager
+ * Epoch-based reclamation for objects that are read without latches.
+ * A reader marks itself active with an EpochGuard. A writer unlinks an object first and then retires it;
+ * the object is freed once every thread that was active when it was retired has left its read section.
+ * It's shared by the whole process, since a thread may read versions of several database instances.
+ */
+class EpochManager {
+public:
+    typedef void (*Deleter)(void *);
+
+    static EpochManager& Instance();
+
+    DISALLOW_COPY_AND_MOVE(EpochManager);
+
+    //! Read sections can be nested.
+    void Enter();
+
+    void Exit();
+    //! The object must be unreachable for new readers already.
+    void Retire(void *object, Deleter deleter);
+    //! Advances the epoch and frees the calling thread's retired objects that are safe to free.
+    void Reclaim();
+    //! Hands the calling thread's retired objects over to the Reclaim calls of the other threads.
+    void HandOver();
+
+private:
+    struct RetiredObject {
+        void *object;
+        Deleter deleter;
+        idx_t epoch;
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<bool> owned{false};
+        //! 0 means the owner is not in a read section.
+        std::atomic<idx_t> epoch{0};
+    };
+
+    struct ThreadState;
+
+    EpochManager() = default;
+
+    ~EpochManager();
+
+    ThreadState& LocalState();
+
+    idx_t AcquireSlot();
+
+    void ReleaseSlot(idx_t slot_id, std::vector<RetiredObject> &&retired);
+
+    idx_t MinActiveEpoch();
+    //! Frees the prefix of `retired` that no active reader can still see.
+    void FreeRetired(std::vector<RetiredObject> &retired);
+
+private:
+    static const idx_t MAX_THREADS = 1024;
+    //! A thread reclaims after retiring this many objects.
+    static const idx_t RECLAIM_THRESHOLD = 64;
+
+    std::atomic<idx_t> global_epoch_{1};
+
+    Slot slots_[MAX_THREADS];
+    //! Slots at or above it were never handed out.
+    std::atomic<idx_t> slot_count_{0};
+    //! Objects left behind by exited threads, or handed over.
+    std::vector<RetiredObject> orphans_;
+
+    std::mutex orphans_latch_;
+};
+
+//! Marks the current thread as reading latch-free data during its lifetime.
+class EpochGuard {
+public:
+    EpochGuard() { EpochManager::Instance().Enter(); }
+
+    ~EpochGuard() { EpochManager::Instance().Exit(); }
+
+    DISALLOW_COPY_AND_MOVE(EpochGuard);
+};
+
+}
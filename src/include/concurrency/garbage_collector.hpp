@@ -0,0 +1,118 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace babydb {
+
+class VersionSkipList;
+
+/**
+ * Retire List
+ * Owners of version lists, like dropped indexes, that no transaction uses anymore. The garbage collector drops
+ * their queued lists and frees them in its next pass. The deleters of the owners share the list, and may run
+ * after the garbage collector is gone: the owner is freed right away then.
+ */
+class RetireList {
+public:
+    RetireList() = default;
+
+    DISALLOW_COPY_AND_MOVE(RetireList);
+    //! owns tells whether a queued list belongs to the owner, release frees the owner.
+    void Retire(std::function<bool(VersionSkipList*)> owns, std::function<void()> release);
+
+private:
+    struct Owner {
+        std::function<bool(VersionSkipList*)> owns;
+
+        std::function<void()> release;
+    };
+
+    std::mutex latch_;
+
+    std::vector<Owner> owners_;
+    //! Set when the garbage collector stops.
+    bool closed_{false};
+
+friend class GarbageCollector;
+};
+
+/**
+ * Garbage Collector
+ * Keeps the watermark, the smallest read ts any running transaction may use, and prunes every version
+ * hidden by a newer version visible at the watermark. Committed writes prune their lists right away against a fresh
+ * watermark and queue the lists that still hold old versions; a background thread drains the queue.
+ */
+class GarbageCollector {
+public:
+    //! interval_ms = 0 starts no background thread, Collect must be called manually then.
+    GarbageCollector(std::function<idx_t()> compute_watermark, idx_t interval_ms);
+
+    ~GarbageCollector();
+
+    DISALLOW_COPY_AND_MOVE(GarbageCollector);
+
+    idx_t GetWatermark() const {
+        return watermark_.load();
+    }
+    //! Whether the versions visible at ts are all kept. Checked after registering a reader at ts,
+    //! a true result holds as long as the reader stays registered.
+    bool Retains(idx_t ts);
+    //! Called after every list of `row_lists` got a new committed version.
+    void AfterCommit(const std::vector<VersionSkipList*> &row_lists);
+    //! Frees row_list, unlinked from its index while ts was the last commit ts, once the watermark passed ts.
+    //! Every transaction that may have found it reads at ts or below.
+    void RetireRowList(VersionSkipList *row_list, idx_t ts);
+    //! Recomputes the watermark, prunes all queued lists and frees the retired owners and row lists.
+    void Collect();
+    //! Where the owners of version lists go once no transaction can write their lists.
+    std::shared_ptr<RetireList> GetRetireList() const {
+        return retired_;
+    }
+
+private:
+    void Enqueue(VersionSkipList *row_list);
+    //! Raises the published watermark to at least watermark, returns the published one.
+    idx_t Publish(idx_t watermark);
+
+    void BackgroundLoop();
+
+private:
+    std::function<idx_t()> compute_watermark_;
+
+    const std::chrono::milliseconds interval_;
+
+    //! Only grows, a late publisher of an older watermark can't lower it.
+    std::atomic<idx_t> watermark_{0};
+    //! Commits between computing and publishing a watermark.
+    std::atomic<idx_t> pruning_{0};
+
+    std::vector<VersionSkipList*> queue_;
+    //! (ts, row list) of RetireRowList.
+    std::vector<std::pair<idx_t, VersionSkipList*>> retired_rows_;
+
+    std::mutex queue_latch_;
+
+    std::mutex collect_latch_;
+
+    std::shared_ptr<RetireList> retired_;
+
+    std::mutex stop_latch_;
+
+    std::condition_variable stop_cv_;
+
+    bool stop_{false};
+
+    std::thread thread_;
+};
+
+}
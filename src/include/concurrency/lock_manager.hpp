@@ -0,0 +1,73 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace babydb {
+
+class Transaction;
+class VersionSkipList;
+
+enum class LockMode : uint8_t {
+    SHARED,
+    EXCLUSIVE
+};
+
+/**
+ * Lock Manager
+ * Row locks for the transactions that lock instead of failing on a write conflict. The lock table is
+ * partitioned by the row's version list, each locked row has a FIFO queue of requests. Deadlocks are
+ * prevented with wound-wait: an older transaction wounds the younger ones it waits for, which abort at
+ * their next lock request or commit, and a younger one waits for the older ones. The age is the priority of the
+ * transaction, so a wounded transaction restarted with BabyDB::RestartTxn keeps its age and eventually wins.
+ * Locks are held until the transaction commits or aborts.
+ */
+class LockManager {
+public:
+    LockManager() = default;
+
+    DISALLOW_COPY_AND_MOVE(LockManager);
+    //! Blocks until txn holds row_list in mode. `upgrade` turns the shared lock of txn into an exclusive one.
+    //! Throws TaintedException if txn got wounded.
+    void Lock(Transaction &txn, VersionSkipList *row_list, LockMode mode, bool upgrade);
+    //! Releases every lock of txn.
+    void ReleaseAll(Transaction &txn);
+
+private:
+    struct Request {
+        Transaction *txn;
+        LockMode mode;
+        bool granted;
+    };
+
+    struct LockQueue {
+        std::list<Request> requests;
+
+        std::condition_variable cv;
+    };
+
+    struct alignas(64) Partition {
+        std::mutex latch;
+
+        std::unordered_map<VersionSkipList*, LockQueue> queues;
+    };
+
+    Partition& PartitionOf(VersionSkipList *row_list);
+    //! Whether the request can be granted now, and wounds the younger transactions it waits for otherwise.
+    static bool TryGrant(LockQueue &queue, std::list<Request>::iterator request);
+
+private:
+    static const idx_t PARTITION_COUNT = 256;
+    //! A waiter checks this often whether an older transaction wounded it.
+    static constexpr std::chrono::microseconds WOUND_CHECK_INTERVAL{500};
+
+    Partition partitions_[PARTITION_COUNT];
+};
+
+}
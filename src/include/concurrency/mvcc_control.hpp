@@ -0,0 +1,44 @@
+#pragma once
+
+#include "concurrency/concurrency_control.hpp"
+#include "concurrency/ssi.hpp"
+
+#include <mutex>
+
+namespace babydb {
+
+/**
+ * MVCC Control
+ * Snapshot isolation: a txn reads at its read ts and the first writer of a row wins.
+ * SERIALIZABLE transactions additionally run SSI.
+ */
+class MvccControl : public ConcurrencyControl {
+public:
+    MvccControl(IsolationLevel isolation_level, const GarbageCollector &gc)
+        : isolation_level_(isolation_level), ssi_(gc) {}
+
+    DISALLOW_COPY_AND_MOVE(MvccControl);
+
+    void Begin(Transaction &txn) override;
+
+    void OnRead(Transaction &txn, VersionSkipList *row_list) override;
+
+    void OnRangeRead(Transaction &txn, SsiPredicateLocks &locks, const RangeInfo &range) override;
+
+    void OnWrite(Transaction &txn, VersionSkipList *row_list) override;
+
+    void OnInsert(Transaction &txn, SsiPredicateLocks &locks, data_t key) override;
+
+    bool PreCommit(Transaction &txn, const std::function<idx_t()> &allocate_ts) override;
+
+    void Finish(Transaction &txn, bool committed) override;
+
+private:
+    const IsolationLevel isolation_level_;
+
+    SsiManager ssi_;
+    //! Only serializes the commit checks of writing SERIALIZABLE transactions.
+    std::mutex commit_latch_;
+};
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "concurrency/concurrency_control.hpp"
+
+namespace babydb {
+
+/**
+ * OCC Control
+ * Optimistic concurrency control in the style of Silo. Reads are not registered anywhere; a txn keeps its
+ * read set and validates it at commit: every row read must still have no newer committed version and
+ * no other writer, and no key may have been inserted into a scanned index. Inserts count at commit, before the ts
+ * is taken, so only inserts that reach the commit disturb the scans of others. The commit ts of a row, its
+ * `lastcommitts`, serves as the TID word, and the claimed uncommitted slot as its lock.
+ * Read-only transactions commit at their read ts without validation, since their snapshot is consistent.
+ */
+class OccControl : public ConcurrencyControl {
+public:
+    OccControl() = default;
+
+    DISALLOW_COPY_AND_MOVE(OccControl);
+
+    void Begin(Transaction &txn) override;
+
+    void OnRead(Transaction &txn, VersionSkipList *row_list) override;
+
+    void OnRangeRead(Transaction &txn, SsiPredicateLocks &locks, const RangeInfo &range) override;
+
+    void OnInsert(Transaction &txn, SsiPredicateLocks &locks, data_t key) override;
+
+    bool PreCommit(Transaction &txn, const std::function<idx_t()> &allocate_ts) override;
+};
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace babydb {
+
+class GarbageCollector;
+class VersionSkipList;
+
+/**
+ * SSI Transaction Info
+ * The serializable snapshot isolation state of one SERIALIZABLE transaction. It is shared with the
+ * SIREAD markers and writer lists it appears in, which may outlive the Transaction itself.
+ */
+struct SsiTxnInfo {
+    SsiTxnInfo(idx_t txn_id, idx_t read_ts) : txn_id(txn_id), read_ts(read_ts) {}
+
+    DISALLOW_COPY_AND_MOVE(SsiTxnInfo);
+
+    const idx_t txn_id;
+
+    const idx_t read_ts;
+    //! Set under `latch` once the commit check passed, INVALID_ID before.
+    std::atomic<idx_t> commit_ts{INVALID_ID};
+
+    std::atomic<bool> aborted{false};
+
+    std::mutex latch;
+    //! A concurrent transaction read a version this one overwrote (an rw-antidependency into it).
+    bool in_conflict{false};
+    //! Committed while an out-neighbor had committed before it. New in-edges would close a dangerous structure.
+    bool committed_pivot{false};
+    //! An in-edge into a committed pivot was found, so this one must abort instead.
+    bool doomed{false};
+    //! Transactions that overwrote something this one read (rw-antidependencies out of it).
+    std::vector<std::shared_ptr<SsiTxnInfo>> out_edges;
+
+    //! No transaction starting at or after `watermark` can form an edge with it anymore.
+    bool Obsolete(idx_t watermark) const {
+        auto ts = commit_ts.load();
+        return aborted.load() || (ts != INVALID_ID && ts <= watermark);
+    }
+};
+
+//! SIREAD markers and the recent writers of one row.
+struct SsiRowState {
+    std::mutex latch;
+
+    std::vector<std::shared_ptr<SsiTxnInfo>> readers;
+
+    std::vector<std::shared_ptr<SsiTxnInfo>> writers;
+};
+
+//! SIREAD markers on key ranges of one index. They catch the keys inserted into a scanned range (phantoms).
+class SsiPredicateLocks {
+public:
+    SsiPredicateLocks() = default;
+
+    DISALLOW_COPY_AND_MOVE(SsiPredicateLocks);
+    //! Keys that got a new leaf by OCC transactions, their scans validate it didn't change.
+    std::atomic<idx_t> insert_count{0};
+
+private:
+    struct RangeMarker {
+        RangeInfo range;
+
+        std::shared_ptr<SsiTxnInfo> reader;
+    };
+
+    std::mutex latch_;
+
+    std::vector<RangeMarker> markers_;
+    //! Obsolete markers are dropped when the vector grows past it.
+    idx_t prune_size_{64};
+
+friend class SsiManager;
+};
+
+/**
+ * SSI Manager
+ * Tracks rw-antidependencies between concurrent SERIALIZABLE transactions and aborts the pivot
+ * T2 of a dangerous structure T1 -> T2 -> T3 in which T3 committed first. A reader is aborted
+ * only when the pivot has committed already.
+ */
+class SsiManager {
+public:
+    explicit SsiManager(const GarbageCollector &gc) : gc_(gc) {}
+
+    DISALLOW_COPY_AND_MOVE(SsiManager);
+
+    void OnRead(const std::shared_ptr<SsiTxnInfo> &reader, VersionSkipList *row_list);
+
+    void OnWrite(const std::shared_ptr<SsiTxnInfo> &writer, VersionSkipList *row_list);
+
+    void OnRangeRead(const std::shared_ptr<SsiTxnInfo> &reader, SsiPredicateLocks &locks, const RangeInfo &range);
+    //! Called for a key that got a new leaf; rows that existed before are covered by OnWrite.
+    void OnInsert(const std::shared_ptr<SsiTxnInfo> &writer, SsiPredicateLocks &locks, data_t key);
+    //! Returns false if `info` must abort. Otherwise it's marked committed at allocate_ts(),
+    //! which runs under its latch, so edges added later see the final state.
+    bool PreCommit(SsiTxnInfo &info, const std::function<idx_t()> &allocate_ts);
+
+    void Finish(SsiTxnInfo &info, bool committed);
+
+private:
+    static void AddEdge(const std::shared_ptr<SsiTxnInfo> &reader, const std::shared_ptr<SsiTxnInfo> &writer);
+
+    static void Prune(std::vector<std::shared_ptr<SsiTxnInfo>> &infos, idx_t watermark);
+
+private:
+    const GarbageCollector &gc_;
+};
+
+}
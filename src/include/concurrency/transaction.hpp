@@ -2,23 +2,43 @@
 
 #include "common/typedefs.hpp"
 #include "common/macro.hpp"
+#include "concurrency/lock_manager.hpp"
+#include "concurrency/write_set.hpp"
 
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace babydb {
 
+class AdmissionController;
+class Catalog;
+class ConcurrencyControl;
+class ContentionManager;
+class Index;
+class SsiPredicateLocks;
+struct SsiTxnInfo;
+class Table;
 class VersionSkipList;
 
+//! Appends the newest committed row (by row id) with the (column, delta) pairs applied and returns the new row id.
+typedef std::function<data_t(data_t, const std::vector<std::pair<idx_t, int64_t>>&)> DeltaMaterializer;
+
 //! Transaction State
 enum TransactionState { RUNNING, TAINTED, COMMITED, ABORTED };
 
 //! The concurrency control is just lock the whole database.
 class Transaction {
 public:
-    explicit Transaction(idx_t txn_id, idx_t read_ts, idx_t gc_ts, std::shared_lock<std::shared_mutex> &&db_lock)
-        : txn_id_(txn_id), read_ts_(read_ts), gc_ts_(gc_ts), db_lock_(std::move(db_lock)) {}
+    //! A retry passes the priority of the aborted attempt, a new txn gets its txn_id.
+    explicit Transaction(idx_t txn_id, idx_t read_ts, std::shared_ptr<const Catalog> catalog,
+                         idx_t priority = INVALID_ID)
+        : txn_id_(txn_id), read_ts_(read_ts), priority_(priority == INVALID_ID ? txn_id : priority),
+          catalog_(std::move(catalog)) {}
 
     DISALLOW_COPY_AND_MOVE(Transaction);
 
@@ -27,13 +47,19 @@ public:
     const idx_t txn_id_;
 
     const idx_t read_ts_;
-
-    const idx_t gc_ts_;
+    //! The age of the txn for the contention policies, smaller is older. Retries keep the one of the first attempt,
+    //! so they get older until they win instead of restarting as the youngest txn.
+    const idx_t priority_;
 
 public:
     void SetTainted() {
         state_ = TAINTED;
     }
+    //! Tainted by a write conflict on row_list.
+    void SetConflict(VersionSkipList *row_list) {
+        conflict_row_ = row_list;
+        SetTainted();
+    }
 
     idx_t GetCommitTs() {
         return commit_ts_;
@@ -43,33 +69,142 @@ public:
         return state_.load();
     }
 
-    void AddModifiedRow(VersionSkipList *row_list) {
-        modified_rows_.push_back(row_list);
+    //! Called after the txn claimed the uncommitted version of row_list.
+    void AddModifiedRow(VersionSkipList *row_list);
+    //! Called after the first delta of the txn on row_list.
+    void AddDeltaRow(VersionSkipList *row_list, DeltaMaterializer &&materialize);
+    //! Called for every row a read looked at, whether a version was visible or not.
+    void AddReadRow(VersionSkipList *row_list);
+    //! Called before scanning a key range of an index.
+    void AddReadRange(SsiPredicateLocks &locks, const RangeInfo &range);
+    //! Called after inserting a key that had no entry in index, row_list is its new version list.
+    void AddInsertedKey(Index &index, VersionSkipList *row_list, SsiPredicateLocks &locks, data_t key);
+    //! Applies the contention policy before claiming row_list.
+    void BeforeWrite(VersionSkipList *row_list);
+    //! Called before every write through index. The first one registers the txn as a writer of the index until
+    //! it finishes, it throws TaintedException if the index was dropped.
+    void BeforeIndexWrite(Index &index);
+
+    //! Whether the txn reads and writes the rows of table under row locks, set for the txn or for the table.
+    bool LocksRows(const Table &table) const;
+    //! Locks row_list and returns the commit ts of the version the txn reads and overwrites there: the newest
+    //! one when the txn first locked the row. Throws TaintedException if an older txn wounded the txn.
+    idx_t LockRow(VersionSkipList *row_list, LockMode mode);
+    //! A write of row_list conflicts with the versions committed after this ts.
+    idx_t WriteTs(VersionSkipList *row_list) const;
+    //! An older txn waits for a row lock of this one, it should abort.
+    void Wound() {
+        wounded_.store(true);
     }
 
-    void AddReadRow(VersionSkipList *row_list) {
-        read_rows_.push_back(row_list);
+    bool Wounded() const {
+        return wounded_.load();
+    }
+
+    //! Throws for AS OF transactions, they only read. The first write waits for the admission of the txn.
+    void CheckWritable() {
+        if (read_only_) {
+            throw std::logic_error("Write in a read-only transaction.");
+        }
+        if (admission_ && !admitted_) {
+            Admit();
+        }
+    }
+
+    bool RowLocking() const {
+        return row_locking_;
+    }
+
+    bool WaitsForWriters() const {
+        return contention_manager_ != nullptr;
+    }
+    //! Reads are only tracked if the concurrency control validates them.
+    bool TracksReads() const {
+        return tracks_reads_;
+    }
+
+    WriteSet& GetWriteSet() {
+        return write_set_;
     }
 
     bool ReadOnly() {
-        return modified_rows_.empty();
+        return modified_rows_.empty() && delta_rows_.empty();
+    }
+
+    //! The catalog version the txn started with, released when it finishes.
+    const Catalog& GetCatalog() const {
+        if (!catalog_) {
+            throw std::logic_error("The transaction has finished.");
+        }
+        return *catalog_;
     }
 
 private:
     void Done();
 
+    void Admit();
+
 private:
     std::atomic<TransactionState> state_{RUNNING};
 
-    std::shared_lock<std::shared_mutex> db_lock_;
+    bool read_only_{false};
+
+    //! Keeps the tables and indexes the txn may use alive, even if they are dropped meanwhile.
+    std::shared_ptr<const Catalog> catalog_;
 
     idx_t commit_ts_{INVALID_ID};
+    //! Where the read ts is registered in the ActiveTxnRegistry.
+    idx_t registry_shard_{INVALID_ID};
+
+    WriteSet write_set_;
 
     std::vector<VersionSkipList*> modified_rows_;
+    //! Rows with commutative deltas, applied on the newest version at commit.
+    std::vector<std::pair<VersionSkipList*, DeltaMaterializer>> delta_rows_;
+    //! The indexes the txn is registered as a writer of.
+    std::vector<Index*> written_indexes_;
+    //! Version lists the txn linked into an index for a new key, unlinked again if it aborts.
+    std::vector<std::pair<Index*, VersionSkipList*>> inserted_rows_;
 
-    std::vector<VersionSkipList*> read_rows_;
+    //! Null if the protocol needs no tracking for this txn.
+    ConcurrencyControl *concurrency_control_{nullptr};
+
+    bool tracks_reads_{false};
+    //! Null under ContentionPolicy::NO_WAIT.
+    ContentionManager *contention_manager_{nullptr};
 
+    VersionSkipList *conflict_row_{nullptr};
+
+    std::shared_ptr<SsiTxnInfo> ssi_info_;
+    //! Read set of an OCC transaction.
+    std::vector<VersionSkipList*> read_rows_;
+    //! Scanned indexes of an OCC transaction, with their insert count before the scan.
+    std::vector<std::pair<SsiPredicateLocks*, idx_t>> read_ranges_;
+    //! Indexes an OCC transaction inserted new keys into, once per key. Counted at commit.
+    std::vector<SsiPredicateLocks*> insert_ranges_;
+    //! Null under OCC, its validation rejects reads newer than the read ts.
+    LockManager *lock_manager_{nullptr};
+    //! Locks the rows of every table.
+    bool row_locking_{false};
+
+    std::atomic<bool> wounded_{false};
+
+    struct RowLock {
+        LockMode mode;
+        //! Ts of the version the txn reads on the row.
+        idx_t read_ts;
+    };
+
+    std::unordered_map<VersionSkipList*, RowLock> row_locks_;
+    //! Null if admission control is off.
+    AdmissionController *admission_{nullptr};
+
+    bool admitted_{false};
+
+friend class LockManager;
 friend class TransactionManager;
+friend class MvccControl;
+friend class OccControl;
 };
 
 }
\ No newline at end of file
@@ -1,38 +1,109 @@
 #pragma once
 
+#include "common/config.hpp"
 #include "common/typedefs.hpp"
+#include "concurrency/active_txn_registry.hpp"
+#include "concurrency/garbage_collector.hpp"
 #include "transaction.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <map>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <string>
 
 namespace babydb {
 
+class AdmissionController;
+class Catalog;
+class ConcurrencyControl;
+class ContentionManager;
+class LockManager;
+
 class TransactionManager {
 public:
-    TransactionManager(IsolationLevel isolation_level = IsolationLevel::SNAPSHOT) : isolation_level_(isolation_level) {}
-    //! Create a new transaction.
-    std::shared_ptr<Transaction> CreateTxn(std::shared_lock<std::shared_mutex> &&db_lock);
+    explicit TransactionManager(const ConfigGroup &config = ConfigGroup());
+
+    ~TransactionManager();
+    //! Create a new transaction. With row_locking, it locks the rows of every table it touches.
+    //! A retry passes the priority of the aborted attempt.
+    std::shared_ptr<Transaction> CreateTxn(std::shared_ptr<const Catalog> catalog, bool row_locking = false,
+                                           idx_t priority = INVALID_ID);
+    //! Create a read-only transaction reading the database as of commit ts. Throws if the versions are gone.
+    std::shared_ptr<Transaction> CreateTxnAsOf(idx_t ts, std::shared_ptr<const Catalog> catalog);
+    //! Names the current commit ts and keeps its versions until the snapshot is dropped. Returns the ts.
+    idx_t CreateSnapshot(const std::string &name);
+
+    void DropSnapshot(const std::string &name);
+    //! The commit ts of a named snapshot.
+    idx_t GetSnapshotTs(const std::string &name);
     //! Commit a transaction, return false if aborted.
     bool Commit(Transaction &txn);
     //! Abort a transaction.
     void Abort(Transaction &txn);
 
+    GarbageCollector& GetGarbageCollector() {
+        return *gc_;
+    }
+    //! Every commit at or below it is visible.
+    idx_t GetVisibleTs() const {
+        return visible_ts_.load();
+    }
+    //! The current cap on running write transactions, 0 if admission control is off.
+    idx_t GetAdmissionLimit();
+
 private:
-    bool VerifyTxn(Transaction &txn);
+    //! The smallest read ts a running or future transaction may use, O(registry shards). Every commit calls it.
+    idx_t ComputeWatermark();
+    //! Called under snapshot_latch_ after snapshots_ changed.
+    void PublishSnapshotMin();
+    //! Release the registration of a finished transaction.
+    void Finish(Transaction &txn, TransactionState state);
+    //! Waits until every commit ts before commit_ts is published: it spins a little, then sleeps. Every later
+    //! commit waits for a ts once it is taken, so nothing between taking a commit ts and publishing it may wait
+    //! for another transaction; short latches are fine.
+    void WaitForPredecessors(idx_t commit_ts);
+    //! Advances the frontier to commit_ts and wakes the sleeping successors.
+    void Publish(idx_t commit_ts);
+    //! Installs the versions of a writing transaction at its commit ts and publishes it.
+    void InstallAndPublish(Transaction &txn);
 
 private:
-    idx_t next_txn_id_{TXN_START_ID};
+    std::atomic<idx_t> next_txn_id_{TXN_START_ID};
+    //! Commit timestamps are handed out here, before the versions are installed.
+    std::atomic<idx_t> next_commit_ts_{1};
+    //! Every commit at or below it is installed; new transactions read at this ts. It advances in commit ts order.
+    std::atomic<idx_t> visible_ts_{0};
+    //! Commits sleeping in WaitForPredecessors.
+    std::atomic<idx_t> publish_waiters_{0};
+
+    std::mutex publish_latch_;
+
+    std::condition_variable publish_cv_;
+
+    static constexpr idx_t PUBLISH_SPINS = 64;
+
+    ActiveTxnRegistry active_txns_;
+
+    //! Named snapshots, name -> commit ts.
+    std::map<std::string, idx_t> snapshots_;
 
-    idx_t last_commit_ts_{0};
+    std::mutex snapshot_latch_;
+    //! The smallest ts of snapshots_, INVALID_ID if none. Read by the watermark without the latch.
+    std::atomic<idx_t> snapshot_min_{INVALID_ID};
 
-    std::unordered_map<idx_t, std::shared_ptr<Transaction>> txn_map_;
+    const idx_t history_retention_;
+    //! Declared after the members its thread reads, so it stops before they are destroyed.
+    std::unique_ptr<GarbageCollector> gc_;
 
-    std::shared_mutex txn_map_latch_;
+    std::unique_ptr<ConcurrencyControl> concurrency_control_;
 
-    std::mutex commit_latch_;
+    std::unique_ptr<ContentionManager> contention_;
+    //! Null under OCC.
+    std::unique_ptr<LockManager> lock_manager_;
 
-    const IsolationLevel isolation_level_;
+    std::unique_ptr<AdmissionController> admission_;
 };
 
 }
\ No newline at end of file
@@ -1,51 +1,124 @@
 #pragma once
 
 #include "common/typedefs.hpp"
+
+#include <atomic>
+#include <functional>
 #include <shared_mutex>
+#include <utility>
+#include <vector>
 
 namespace babydb {
 
+struct SsiRowState;
+
 void RegisterVersionNode();
 
 void UnregisterVersionNode();
 
-const int MAXLEVEL = 18;
-
+//! One version of a key. Committed versions form a chain from the newest to the oldest.
 struct Datalist {
     data_t data;
     idx_t ts;
-    Datalist* ptr[MAXLEVEL];
+    std::atomic<Datalist*> next;
     idx_t txn_id;
 
-    Datalist(idx_t ts, data_t data, idx_t txn_id) : data(data), ts(ts), txn_id(txn_id) {for (int i = 0; i < MAXLEVEL; i++) ptr[i] = nullptr;}
+    Datalist(idx_t ts, data_t data, idx_t txn_id) : data(data), ts(ts), next(nullptr), txn_id(txn_id) {RegisterVersionNode();}
     ~Datalist() {UnregisterVersionNode();}
 };
 
+static_assert(sizeof(Datalist) <= 32, "a version record should stay within 32 bytes");
+
 void destroy_list(Datalist* head);
 
+//! Immutable sorted copy of a long version chain, so old snapshots don't walk the whole chain.
+struct VersionIndex {
+    //! (ts, data), ascending by ts.
+    std::vector<std::pair<idx_t, data_t>> versions;
+
+    data_t Search(idx_t ts) const;
+};
+
+//! A pending commutative update of a running transaction.
+struct DeltaIntent {
+    idx_t txn_id;
+    idx_t column;
+    int64_t delta;
+};
+
+/**
+ * Version Skip List
+ * Committed versions of one key, newest first. Most readers want one of the first versions, so the chain
+ * is walked from the head; keys with long histories additionally get a VersionIndex.
+ * Readers search it without latches; versions unlinked by the garbage collector are freed through the EpochManager.
+ */
 class VersionSkipList {
 public:
     data_t key;
-    Datalist* data[MAXLEVEL];
-    Datalist* uncommitted;
+    std::atomic<Datalist*> newest;
+    std::atomic<Datalist*> uncommitted;
 
-    idx_t lastcommitts;
-    VersionSkipList(data_t key, Datalist* uncommitted) : key(key), uncommitted(uncommitted) {for (int i = 0; i < MAXLEVEL; i++) {data[i] = nullptr;}}
+    std::atomic<idx_t> lastcommitts{0};
+    //! Set while the list is queued in the GarbageCollector.
+    std::atomic<bool> gc_queued{false};
+    //! Recent write conflicts, halved by every commit.
+    std::atomic<uint32_t> conflict_count{0};
+
+    VersionSkipList(data_t key, Datalist* uncommitted) : key(key), newest(nullptr), uncommitted(uncommitted) {}
 
     void insert_list(data_t data_in, idx_t ts, idx_t txn_id);
+    //! Links a version that no reader of the chain has seen yet, by its ts.
+    void link_version(Datalist* version);
     void insert_uncommitted_list(data_t data_in, idx_t ts, idx_t txn_id);
     void commit(idx_t ts);
     void rollback(idx_t txn_id);
-    void garbage_collect(idx_t ts);
+    //! Drops the versions hidden by the newest version visible at gc_ts.
+    //! Returns true if the list still holds more than one committed version.
+    bool garbage_collect(idx_t gc_ts);
     data_t search_list(idx_t ts, idx_t txn_id);
+    //! No committed or uncommitted version and no delta.
+    bool is_empty();
+    //! True if no version was committed after ts, and no txn but txn_id holds the row.
+    bool validate_read(idx_t ts, idx_t txn_id);
+    //! Adds delta to column for txn_id. Concurrent deltas don't conflict with each other, only with an uncommitted
+    //! version of another txn. With a bound, committed_value(row id) reads the column of a committed row,
+    //! and the delta is refused if the column could leave the bound. Returns true for the first delta of txn_id.
+    bool insert_delta(idx_t txn_id, idx_t column, int64_t delta, const EscrowBound *bound,
+                      const std::function<data_t(data_t)> &committed_value);
+    //! The pending (column, delta) pairs of txn_id.
+    std::vector<std::pair<idx_t, int64_t>> get_deltas(idx_t txn_id);
+    //! Installs row_id, the newest version with the deltas of txn_id applied, and drops the deltas.
+    void commit_deltas(data_t row_id, idx_t ts, idx_t txn_id);
+    void rollback_deltas(idx_t txn_id);
+    //! SIREAD markers and writers of SERIALIZABLE transactions, created on first use.
+    SsiRowState* GetSsiState();
+
+    ~VersionSkipList();
+
+private:
+    //! Rebuilds the index once the chain has grown to twice its size.
+    void MaybeRebuildIndex();
 
-    ~VersionSkipList() {destroy_list(data[0]);if (uncommitted) {delete uncommitted;UnregisterVersionNode();}}
+    void RetireIndex();
+
+    void rollback_deltas_locked(idx_t txn_id);
 
 private:
+    //! Chains at least this long get a VersionIndex.
+    static const idx_t INDEX_THRESHOLD = 32;
+
+    std::atomic<VersionIndex*> index_{nullptr};
+
+    std::atomic<SsiRowState*> ssi_state_{nullptr};
+
+    std::vector<DeltaIntent> deltas_;
+
+    idx_t chain_length_{0};
+
     std::shared_mutex list_latch_;
 
 };
 
 
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "common/macro.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace babydb {
+
+class Table;
+
+/**
+ * Write Set
+ * The new tuples of a transaction, private until it commits. A tuple gets a local row id, which a versioned
+ * index holds in the uncommitted version of the key, so the transaction reads its own writes through the index.
+ * The commit appends the tuples of each table in one batch, and an aborted transaction leaves no rows behind.
+ */
+class WriteSet {
+public:
+    WriteSet() = default;
+
+    DISALLOW_COPY_AND_MOVE(WriteSet);
+
+    static bool IsLocalRow(idx_t row_id) {
+        return row_id != INVALID_ID && (row_id & LOCAL_ROW_FLAG) != 0;
+    }
+    //! Returns the local row id of the tuple. A key written before by the txn keeps its row id, rewritten is set then.
+    idx_t Write(Table &table, data_t key, Tuple &&tuple, bool &rewritten);
+
+    const Tuple& LocalTuple(idx_t row_id) const;
+    //! Appends the tuples to their tables, holding each table guard once.
+    void Install();
+    //! The table row id of a local row after Install. Other row ids are returned as they are.
+    idx_t InstalledRow(idx_t row_id) const;
+
+private:
+    struct TableWrites {
+        Table *table;
+        std::vector<Tuple> tuples;
+        //! key -> slot in tuples
+        std::unordered_map<data_t, idx_t> slots;
+        //! Row id of the first tuple once installed.
+        idx_t base_row_id{INVALID_ID};
+    };
+
+    static const idx_t LOCAL_ROW_FLAG = idx_t(1) << 63;
+    //! Local row ids are the flag, the table number and the slot.
+    static const idx_t TABLE_SHIFT = 40;
+
+    static const idx_t SLOT_MASK = (idx_t(1) << TABLE_SHIFT) - 1;
+
+    std::vector<TableWrites> tables_;
+};
+
+}
@@ -1,40 +1,84 @@
-#include "execution/operator.hpp"
+#pragma once
 
-#include <unordered_map>
+#include "execution/aggregate_table.hpp"
+#include "execution/memory_budget.hpp"
+#include "execution/operator.hpp"
+#include "execution/spill_file.hpp"
 
 namespace babydb {
 
 /**
  * Aggregate Operator
- * We only support summary aggregation on one column
- * The output schema is [aggregate column, aggregate value]
+ * Groups by any number of columns and computes COUNT/SUM/MIN/MAX/AVG over columns.
+ * The output schema is [group by columns..., aggregates...], an aggregate is named like SUM(column) or COUNT(*).
+ * Without group by columns the output is one row even for an empty input. There are no NULLs, so over no rows
+ * every aggregate is 0: COUNT and SUM as usual, and MIN, MAX and AVG, which have no value, as well.
+ * A parallel child pipeline aggregates into a table per worker, the tables are merged partition by partition.
+ * A table exceeding the memory budget of the query spills its partial aggregates into partitions on disk.
+ * Each partition is aggregated on its own when the output reaches it, and splits again if it is still too large.
  */
 class AggregateOperator : public Operator {
 public:
     AggregateOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
-                      const std::string &group_by, const std::string &aggregate_key);
+                      const Schema &group_by, const std::vector<AggregateFunction> &aggregates);
+    //! SUM(aggregate_column) grouped by one column.
+    AggregateOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
+                      const std::string &group_by, const std::string &aggregate_column);
 
     ~AggregateOperator() override = default;
 
-    OperatorState Next(Chunk &output_chunk) override;
+    OperatorState Next(DataChunk &output_chunk) override;
 
     void SelfInit() override;
 
     void SelfCheck() override;
+    //! The spilled partitions read back since Init.
+    idx_t SpilledPartitionCount() const {
+        return spilled_partition_count_;
+    }
 
 private:
+    //! Partitions of the per worker tables, enough for the merge to keep every worker busy.
+    static constexpr idx_t MAX_RADIX_BITS = 6;
+
     void BuildHashTable();
+    //! Adds chunk to a worker table, which spills if the budget can't hold it.
+    void AddChunk(AggregateTable &table, MemoryReservation &reservation, const DataChunk &chunk);
+
+    std::shared_ptr<PartitionedSpill> GetSpill(const AggregateTable &table);
+    //! Spills the rest of the groups, and queues the partitions of the spill.
+    void SpillAll(std::vector<AggregateTable> &tables);
+    //! Aggregates the next spilled partition into results_, or spills it to the next level.
+    void AggregateSpilledPartition();
 
 private:
-    std::string group_by_;
+    Schema group_by_;
+
+    std::vector<AggregateFunction> aggregates_;
+
+    std::vector<idx_t> key_attrs_;
+
+    std::vector<idx_t> input_attrs_;
+
+    std::vector<AggregateType> types_;
+    //! Results of the groups in memory or of the last spilled partition.
+    DataChunk results_;
+
+    MemoryReservation reservation_;
+    //! The spill of the first phase, created on demand.
+    std::shared_ptr<PartitionedSpill> spill_;
 
-    std::string aggregate_column_;
+    std::mutex spill_latch_;
+    //! Spilled partitions not yet aggregated.
+    std::vector<std::pair<std::shared_ptr<PartitionedSpill>, idx_t>> spilled_partitions_;
 
-    std::unordered_multimap<data_t, data_t> hash_table_;
+    idx_t spilled_partition_count_{0};
 
-    std::unordered_multimap<data_t, data_t>::iterator output_ptr_;
+    idx_t output_position_{0};
+    //! Rows output since Init.
+    idx_t output_count_{0};
 
     bool hash_table_build_{false};
 };
 
-}
\ No newline at end of file
+}
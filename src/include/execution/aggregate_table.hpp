@@ -0,0 +1,118 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "execution/data_chunk.hpp"
+
+namespace babydb {
+
+class PartitionedSpill;
+class ThreadPool;
+
+enum class AggregateType : uint8_t {
+    COUNT,
+    SUM,
+    MIN,
+    MAX,
+    //! The integer part of the mean.
+    AVG
+};
+
+struct AggregateFunction {
+    AggregateType type;
+    //! INVALID_NAME for COUNT(*).
+    std::string column_name;
+};
+
+/**
+ * Aggregate Table
+ * The groups of one aggregation worker. A group keeps its keys and the states of all its aggregates inline in one
+ * flat array, and a linear probing table maps the hash of the keys to the group. The groups are radix partitioned
+ * by the high bits of the hash, so the tables of several workers are merged partition by partition in parallel.
+ * A single group key below DIRECT_LIMIT skips hashing: its group is found by indexing a direct array, which only
+ * grows as large as the largest such key, so dense small domains never touch the hash table.
+ */
+class AggregateTable {
+public:
+    AggregateTable(idx_t key_count, const std::vector<AggregateType> &aggregates, idx_t radix_bits);
+    //! Adds the selected rows of chunk, the group keys are at key_attrs, aggregate i reads input_attrs[i].
+    void AddChunk(const DataChunk &chunk, const std::vector<idx_t> &key_attrs, const std::vector<idx_t> &input_attrs);
+    //! Merges the groups of others, which have the same aggregates and partitions. Every partition and every range
+    //! of the direct array is a task of its own.
+    void Merge(const std::vector<AggregateTable> &others, ThreadPool &thread_pool);
+    //! Appends every group as a row [keys..., aggregates...].
+    void Finalize(DataChunk &output) const;
+    //! Moves every group to spill as a row [keys..., states...], and leaves the table empty.
+    void Spill(PartitionedSpill &spill);
+    //! Combines the rows of a spilled table.
+    void AddStates(const DataChunk &chunk);
+
+    idx_t SpillColumnCount() const {
+        return key_count_ + state_width_;
+    }
+    //! Bytes of the arrays of the table.
+    idx_t MemoryUsage() const;
+
+    static constexpr idx_t DIRECT_LIMIT = 1 << 16;
+
+private:
+    struct Partition {
+        //! Groups one after another, each holds key_count_ keys and then state_width_ states.
+        std::vector<data_t> groups;
+        //! Group index, INVALID_ID if empty.
+        std::vector<idx_t> slots;
+
+        idx_t group_count{0};
+    };
+    static constexpr idx_t DIRECT_MERGE_RANGE = 4096;
+
+    idx_t PartitionOf(uint64_t hash) const {
+        return radix_bits_ == 0 ? 0 : hash >> (64 - radix_bits_);
+    }
+
+    idx_t GroupWidth() const {
+        return key_count_ + state_width_;
+    }
+
+    idx_t DirectSize() const {
+        return direct_.size() / direct_width_;
+    }
+    //! Returns the offset of the states of the group in partition.groups.
+    idx_t FindOrCreate(Partition &partition, const data_t *keys, uint64_t hash);
+
+    void Grow(Partition &partition);
+    //! Returns the offset of the states of the direct group of key in direct_.
+    idx_t FindOrCreateDirect(data_t key);
+
+    void MergePartition(const AggregateTable &other, idx_t partition);
+    //! Keys in [begin, end), direct_ already covers them.
+    void MergeDirect(const AggregateTable &other, idx_t begin, idx_t end);
+
+    //! Calls function(keys, states) for every group.
+    template <class Function>
+    void ForEachGroup(const Function &function) const;
+
+    void InitStates(data_t *states) const;
+
+    void CombineStates(data_t *states, const data_t *other) const;
+
+    uint64_t HashKeys(const data_t *keys) const;
+
+private:
+    idx_t key_count_;
+
+    std::vector<AggregateType> aggregates_;
+    //! Where the state of aggregate i begins, AVG keeps a sum and a count.
+    std::vector<idx_t> state_offsets_;
+
+    idx_t state_width_{0};
+
+    idx_t radix_bits_;
+
+    std::vector<Partition> partitions_;
+    //! Entries of direct_width_ = 1 + state_width_ values, the first one tells if the group exists.
+    std::vector<data_t> direct_;
+
+    idx_t direct_width_;
+};
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "common/hash.hpp"
+#include "common/typedefs.hpp"
+
+namespace babydb {
+
+/**
+ * Bloom Filter
+ * Register blocked: the bits of a key all lie in one 64-bit word, so a check costs one memory access.
+ * It never rejects a key added to it, and accepts a key not added with a probability of about 1%.
+ */
+class BloomFilter {
+public:
+    explicit BloomFilter(const std::vector<data_t> &keys);
+
+    bool MayContain(data_t key) const {
+        auto hash = HashKey(key);
+        auto mask = KeyMask(hash);
+        return (words_[hash & word_mask_] & mask) == mask;
+    }
+
+private:
+    static constexpr idx_t BITS_PER_KEY = 16;
+    //! The bits of a key in its word, chosen by the high bits of the hash. The low ones choose the word.
+    static uint64_t KeyMask(uint64_t hash) {
+        return (uint64_t(1) << (hash >> 58)) | (uint64_t(1) << ((hash >> 52) & 63)) |
+               (uint64_t(1) << ((hash >> 46) & 63));
+    }
+
+private:
+    std::vector<uint64_t> words_;
+
+    idx_t word_mask_;
+};
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+
+#include <initializer_list>
+#include <vector>
+
+namespace babydb {
+
+class VersionSkipList;
+
+//! Where an output tuple comes from. A scan through a versioned index also passes the version list of the row
+//! and the ts it read the list at, so a following update of the row doesn't search the index again.
+struct RowHandle {
+    idx_t row_id;
+    //! Nullptr if unknown.
+    VersionSkipList *row_list;
+    //! row_id is the newest version of row_list committed at or before it.
+    idx_t read_ts;
+
+    RowHandle(idx_t row_id = INVALID_ID, VersionSkipList *row_list = nullptr, idx_t read_ts = INVALID_ID)
+        : row_id(row_id), row_list(row_list), read_ts(read_ts) {}
+};
+
+/**
+ * Data Chunk
+ * A batch of rows in columnar layout: a contiguous array per column and the row handle of every row.
+ * The selection vector picks the rows that are part of the chunk, so a filter only shrinks the selection
+ * and a projection only adds columns. Without a selection every row is selected.
+ * Rows are addressed by their position in the selection, columns are indexed by physical row.
+ */
+class DataChunk {
+public:
+    DataChunk() = default;
+    //! Drops the rows and the selection, and keeps column_count empty columns.
+    void Reset(idx_t column_count);
+
+    idx_t ColumnCount() const {
+        return columns_.size();
+    }
+    //! Number of selected rows.
+    idx_t Size() const {
+        return has_selection_ ? selection_.size() : handles_.size();
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    bool HasSelection() const {
+        return has_selection_;
+    }
+    //! The physical row of the selected row at position.
+    idx_t RowIndex(idx_t position) const {
+        return has_selection_ ? selection_[position] : position;
+    }
+
+    data_t GetValue(idx_t column, idx_t position) const {
+        return columns_[column][RowIndex(position)];
+    }
+
+    const RowHandle& GetHandle(idx_t position) const {
+        return handles_[RowIndex(position)];
+    }
+    //! Materializes the selected row at position.
+    Tuple GetTuple(idx_t position) const;
+    //! Materializes the attrs of the selected row at position.
+    Tuple GetTuple(idx_t position, const std::vector<idx_t> &attrs) const;
+
+    std::vector<data_t>& Column(idx_t column) {
+        return columns_[column];
+    }
+
+    const std::vector<data_t>& Column(idx_t column) const {
+        return columns_[column];
+    }
+
+    void Append(const Tuple &tuple, RowHandle handle = RowHandle());
+
+    void Append(std::initializer_list<data_t> values, RowHandle handle = RowHandle());
+    //! Appends the attrs of tuple as a row.
+    void Append(const Tuple &tuple, const std::vector<idx_t> &attrs, RowHandle handle);
+    //! Appends the selected rows of source, which has the same columns.
+    void Append(const DataChunk &source);
+    //! Only for callers that push to every Column themselves.
+    void AppendHandle(RowHandle handle) {
+        handles_.push_back(handle);
+    }
+    //! The physical rows currently selected, ascending.
+    std::vector<idx_t> SelectedRows() const;
+    //! Selects the given physical rows, ascending.
+    void Select(std::vector<idx_t> &&selection);
+    //! Replaces the columns, each holds a value for every physical row.
+    void SetColumns(std::vector<std::vector<data_t>> &&columns) {
+        columns_ = std::move(columns);
+    }
+
+private:
+    std::vector<std::vector<data_t>> columns_;
+
+    std::vector<RowHandle> handles_;
+
+    std::vector<idx_t> selection_;
+
+    bool has_selection_{false};
+};
+
+}
@@ -16,7 +16,7 @@ public:
 
     ~DeleteOperator() override = default;
 
-    OperatorState Next(Chunk &) override;
+    OperatorState Next(DataChunk &) override;
 
     void SelfInit() override {}
 
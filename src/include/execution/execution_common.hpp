@@ -5,11 +5,16 @@
 namespace babydb {
 
 class Index;
+class Table;
 struct ExecutionContext;
 class Transaction;
+struct RowHandle;
 class WriteTableGuard;
 
-//! Insert (or cover) a tuple to a table
-void InsertRow(WriteTableGuard &write_guard, Tuple &&tuple, Index *index, const data_t &key, ExecutionContext &exec_ctx);
+//! Insert (or cover) a tuple to a table. With a versioned index the tuple stays in the write set of the txn until it commits.
+void InsertRow(Table &table, WriteTableGuard &write_guard, Tuple &&tuple, Index *index, const data_t &key, ExecutionContext &exec_ctx);
+//! Cover the row of a versioned index, whose version list came with the row handle. Needs no table guard.
+//! Conflicts if a version was committed after the one the handle observed.
+void UpdateRow(Table &table, Index &index, const RowHandle &handle, Tuple &&tuple, ExecutionContext &exec_ctx);
 
 }
\ No newline at end of file
@@ -1,14 +1,22 @@
 #pragma once
 
+#include <memory>
+
 namespace babydb {
 
 class Transaction;
 class Catalog;
 struct ConfigGroup;
+class ThreadPool;
+class MemoryBudget;
+
 struct ExecutionContext {
     Transaction &txn_;
     const Catalog &catalog_;
     const ConfigGroup &config_;
+    ThreadPool &thread_pool_;
+    //! Shared by the operators built from this context, nullptr means no limit.
+    std::shared_ptr<MemoryBudget> memory_budget_;
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "execution/data_chunk.hpp"
+
+#include <memory>
+
+namespace babydb {
+
+enum class ExpressionType {
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    MODULO,
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    AND,
+    OR
+};
+
+/**
+ * Expression
+ * A typed expression tree evaluated a vector at a time. Every value is a data_t, a comparison or a logic operator
+ * gives 1 for true and 0 for false, any other value is true. The arithmetic wraps around like data_t does.
+ * Before evaluating, Bind(columns) assigns every column reference its position in columns, the values of the
+ * bound columns are then passed as a tuple or as a map to the columns of a chunk.
+ */
+class Expression {
+public:
+    virtual ~Expression() = default;
+    //! Adds the missing column names of the references to columns.
+    virtual void Bind(Schema &columns) = 0;
+    //! Evaluates on one row, keys holds the values of the bound columns.
+    virtual data_t Evaluate(const Tuple &keys) const = 0;
+    //! Evaluates on the physical rows of chunk into output, the bound column i is the column column_map[i] of chunk.
+    virtual void Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                          const std::vector<idx_t> &rows, std::vector<data_t> &output) const = 0;
+};
+
+//! Binds expression, returns the columns it references in the order of their first reference.
+inline Schema BindColumns(Expression &expression) {
+    Schema columns;
+    expression.Bind(columns);
+    return columns;
+}
+
+class ColumnRefExpression : public Expression {
+public:
+    explicit ColumnRefExpression(const std::string &column_name) : column_name_(column_name) {}
+
+    void Bind(Schema &columns) override;
+
+    data_t Evaluate(const Tuple &keys) const override {
+        return keys[position_];
+    }
+
+    void Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                  const std::vector<idx_t> &rows, std::vector<data_t> &output) const override;
+
+private:
+    std::string column_name_;
+
+    idx_t position_{INVALID_ID};
+};
+
+class ConstantExpression : public Expression {
+public:
+    explicit ConstantExpression(data_t value) : value_(value) {}
+
+    void Bind(Schema &) override {}
+
+    data_t Evaluate(const Tuple &) const override {
+        return value_;
+    }
+
+    void Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                  const std::vector<idx_t> &rows, std::vector<data_t> &output) const override {
+        output.assign(rows.size(), value_);
+    }
+
+private:
+    data_t value_;
+};
+
+/**
+ * Binary Expression
+ * AND and OR only evaluate the right side on the rows their left side doesn't decide.
+ */
+class BinaryExpression : public Expression {
+public:
+    BinaryExpression(ExpressionType type, std::unique_ptr<Expression> &&left, std::unique_ptr<Expression> &&right);
+
+    void Bind(Schema &columns) override {
+        left_->Bind(columns);
+        right_->Bind(columns);
+    }
+
+    data_t Evaluate(const Tuple &keys) const override;
+
+    void Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                  const std::vector<idx_t> &rows, std::vector<data_t> &output) const override;
+
+private:
+    void EvaluateLogic(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                       const std::vector<idx_t> &rows, std::vector<data_t> &output) const;
+
+private:
+    ExpressionType type_;
+
+    std::unique_ptr<Expression> left_;
+
+    std::unique_ptr<Expression> right_;
+};
+
+class NotExpression : public Expression {
+public:
+    explicit NotExpression(std::unique_ptr<Expression> &&child) : child_(std::move(child)) {}
+
+    void Bind(Schema &columns) override {
+        child_->Bind(columns);
+    }
+
+    data_t Evaluate(const Tuple &keys) const override {
+        return child_->Evaluate(keys) == 0;
+    }
+
+    void Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                  const std::vector<idx_t> &rows, std::vector<data_t> &output) const override;
+
+private:
+    std::unique_ptr<Expression> child_;
+};
+
+/**
+ * Case Expression
+ * CASE WHEN condition THEN then ELSE otherwise END. Each branch is only evaluated on the rows taking it.
+ */
+class CaseExpression : public Expression {
+public:
+    CaseExpression(std::unique_ptr<Expression> &&condition, std::unique_ptr<Expression> &&then,
+                   std::unique_ptr<Expression> &&otherwise)
+        : condition_(std::move(condition)), then_(std::move(then)), otherwise_(std::move(otherwise)) {}
+
+    void Bind(Schema &columns) override {
+        condition_->Bind(columns);
+        then_->Bind(columns);
+        otherwise_->Bind(columns);
+    }
+
+    data_t Evaluate(const Tuple &keys) const override {
+        return condition_->Evaluate(keys) != 0 ? then_->Evaluate(keys) : otherwise_->Evaluate(keys);
+    }
+
+    void Evaluate(const DataChunk &chunk, const std::vector<idx_t> &column_map,
+                  const std::vector<idx_t> &rows, std::vector<data_t> &output) const override;
+
+private:
+    std::unique_ptr<Expression> condition_;
+
+    std::unique_ptr<Expression> then_;
+
+    std::unique_ptr<Expression> otherwise_;
+};
+
+}
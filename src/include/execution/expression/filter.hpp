@@ -1,14 +1,18 @@
 #pragma once
 
 #include "common/typedefs.hpp"
+#include "execution/data_chunk.hpp"
+#include "execution/expression/expression.hpp"
+#include "execution/expression/predicate_kernels.hpp"
 
 #include <functional>
+#include <limits>
 
 namespace babydb {
 
 /**
  * Filter
- * Before call Check(tuple), you should call Init(input schema) at least once.
+ * Before call Check(tuple) or Select(chunk, selection), you should call Init(input schema) at least once.
  */
 class Filter {
 public:
@@ -22,14 +26,25 @@ public:
         return CheckInternal(tuple.KeysFromTuple(key_attrs_));
     }
 
+    //! Keeps the physical rows of chunk in selection that satisfy the condition, in order.
+    void Select(const DataChunk &chunk, std::vector<idx_t> &selection) const {
+        SelectInternal(chunk, selection);
+    }
+
     void Init(const Schema &input_schema) {
         key_attrs_ = input_schema.GetKeyAttrs(keys_schema_);
     }
+    //! Returns true if the filter is a range on one column, the range kernels of several filters run fused.
+    virtual bool GetColumnRange(ColumnRange &range) const {
+        return false;
+    }
 
 private:
     virtual bool CheckInternal(Tuple &&check_keys) const = 0;
+    //! Calls CheckInternal row by row, the filters on one column override it with a loop over the column.
+    virtual void SelectInternal(const DataChunk &chunk, std::vector<idx_t> &selection) const;
 
-private:
+protected:
     std::vector<idx_t> key_attrs_;
 };
 
@@ -46,19 +61,40 @@ public:
         : Filter({column_name}), range_(range) {}
     ~RangeFilter() override {}
 
+    bool GetColumnRange(ColumnRange &range) const override {
+        // An open end at the limit of data_t leaves the range empty.
+        if ((!range_.contain_start && range_.start == std::numeric_limits<data_t>::max()) ||
+            (!range_.contain_end && range_.end == 0)) {
+            range = ColumnRange{key_attrs_[0], 1, 0};
+            return true;
+        }
+        range = ColumnRange{key_attrs_[0], range_.start + !range_.contain_start, range_.end - !range_.contain_end};
+        return true;
+    }
+
 private:
-    bool CheckInternal(Tuple &&tuple) const override {
-        if (tuple[0] < range_.start || tuple[0] > range_.end) {
+    bool InRange(data_t key) const {
+        if (key < range_.start || key > range_.end) {
             return false;
         }
-        if (!range_.contain_start && tuple[0] == range_.start) {
+        if (!range_.contain_start && key == range_.start) {
             return false;
         }
-        if (!range_.contain_end && tuple[0] == range_.end) {
+        if (!range_.contain_end && key == range_.end) {
             return false;
         }
         return true;
     }
+
+    bool CheckInternal(Tuple &&tuple) const override {
+        return InRange(tuple[0]);
+    }
+
+    void SelectInternal(const DataChunk &chunk, std::vector<idx_t> &selection) const override {
+        ColumnRange range;
+        GetColumnRange(range);
+        NarrowRanges(chunk, {range}, selection);
+    }
 };
 
 /**
@@ -77,10 +113,52 @@ public:
     bool CheckInternal(Tuple &&tuple) const override {
         return tuple[0] == target_key_;
     }
+
+    bool GetColumnRange(ColumnRange &range) const override {
+        range = ColumnRange{key_attrs_[0], target_key_, target_key_};
+        return true;
+    }
+
+private:
+    void SelectInternal(const DataChunk &chunk, std::vector<idx_t> &selection) const override {
+        NarrowRanges(chunk, {ColumnRange{key_attrs_[0], target_key_, target_key_}}, selection);
+    }
+};
+
+/**
+ * Expression Filter
+ * Only accept rows the expression gives a non-zero value for.
+ */
+class ExpressionFilter : public Filter {
+public:
+    explicit ExpressionFilter(std::unique_ptr<Expression> &&expression)
+        : Filter(BindColumns(*expression)), expression_(std::move(expression)) {}
+    ~ExpressionFilter() override {}
+
+private:
+    bool CheckInternal(Tuple &&tuple) const override {
+        return expression_->Evaluate(tuple) != 0;
+    }
+
+    void SelectInternal(const DataChunk &chunk, std::vector<idx_t> &selection) const override {
+        std::vector<data_t> result;
+        expression_->Evaluate(chunk, key_attrs_, selection, result);
+        idx_t count = 0;
+        for (idx_t i = 0; i < selection.size(); i++) {
+            if (result[i] != 0) {
+                selection[count++] = selection[i];
+            }
+        }
+        selection.resize(count);
+    }
+
+private:
+    std::unique_ptr<Expression> expression_;
 };
 
 /**
  * User Define Filter
+ * Calls udf once per row with a freshly built tuple, prefer ExpressionFilter when the condition can be expressed.
  */
 class UDFilter : public Filter {
 public:
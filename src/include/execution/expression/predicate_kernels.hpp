@@ -0,0 +1,39 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "execution/data_chunk.hpp"
+
+namespace babydb {
+
+//! low <= value <= high on one column of a chunk. low > high selects nothing.
+struct ColumnRange {
+    idx_t column;
+
+    data_t low;
+
+    data_t high;
+};
+
+enum class SimdLevel : uint8_t {
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+//! The widest level the CPU supports, or the one set by SetSimdLevel.
+SimdLevel GetSimdLevel();
+//! Caps the kernels at level, for testing. A level the CPU lacks falls back to the widest supported one.
+void SetSimdLevel(SimdLevel level);
+
+/**
+ * Range kernels
+ * Select the rows satisfying every range in one fused pass over the columns. Without a selection, the chunk is
+ * compared a whole vector of rows at a time into a bitmask, which is compacted into the selection. Selected rows
+ * are compared one at a time, gathering them wouldn't be faster than the scalar loop.
+ */
+//! Writes the selected rows of chunk satisfying every range to selection.
+void SelectRanges(const DataChunk &chunk, const std::vector<ColumnRange> &ranges, std::vector<idx_t> &selection);
+//! Keeps the physical rows of chunk in selection satisfying every range, in order.
+void NarrowRanges(const DataChunk &chunk, const std::vector<ColumnRange> &ranges, std::vector<idx_t> &selection);
+
+}
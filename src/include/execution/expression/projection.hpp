@@ -1,6 +1,8 @@
 #pragma once
 
 #include "common/typedefs.hpp"
+#include "execution/data_chunk.hpp"
+#include "execution/expression/expression.hpp"
 
 #include <functional>
 
@@ -8,7 +10,7 @@ namespace babydb {
 
 /**
  * Filter
- * Before call Calc(tuple), you should call Init(input schema) at least once.
+ * Before call Calc(tuple) or Calc(chunk, output), you should call Init(input schema) at least once.
  */
 class Projection {
 public:
@@ -25,14 +27,25 @@ public:
         return CalcInternal(tuple.KeysFromTuple(key_attrs_));
     }
 
+    //! Calculates the data of every selected row of chunk into output, in order.
+    void Calc(const DataChunk &chunk, std::vector<data_t> &output) const {
+        CalcColumn(chunk, output);
+    }
+
     void Init(const Schema &input_schema) {
         key_attrs_ = input_schema.GetKeyAttrs(keys_schema_);
     }
+    //! The input column if the output is just its value, otherwise INVALID_NAME.
+    virtual std::string PassThroughColumn() const {
+        return INVALID_NAME;
+    }
 
 private:
     virtual data_t CalcInternal(Tuple &&check_keys) const = 0;
+    //! Calls CalcInternal row by row.
+    virtual void CalcColumn(const DataChunk &chunk, std::vector<data_t> &output) const;
 
-private:
+protected:
     std::vector<idx_t> key_attrs_;
 };
 
@@ -49,15 +62,45 @@ public:
 
     ~UnitProjection() override {}
 
+    std::string PassThroughColumn() const override {
+        return keys_schema_[0];
+    }
+
 private:
     data_t CalcInternal(Tuple &&check_keys) const override {
         return check_keys[0];
     }
+    //! Copies the column.
+    void CalcColumn(const DataChunk &chunk, std::vector<data_t> &output) const override;
+};
+
+/**
+ * Expression Projection
+ * Outputs the value of the expression.
+ */
+class ExpressionProjection : public Projection {
+public:
+    ExpressionProjection(const std::string &output_name, std::unique_ptr<Expression> &&expression)
+        : Projection(BindColumns(*expression), output_name), expression_(std::move(expression)) {}
+
+    ~ExpressionProjection() override {}
+
+private:
+    data_t CalcInternal(Tuple &&check_keys) const override {
+        return expression_->Evaluate(check_keys);
+    }
+
+    void CalcColumn(const DataChunk &chunk, std::vector<data_t> &output) const override {
+        expression_->Evaluate(chunk, key_attrs_, chunk.SelectedRows(), output);
+    }
+
+private:
+    std::unique_ptr<Expression> expression_;
 };
 
 /**
  * User Define Projection
- * Just output the input
+ * Calls udf once per row with a freshly built tuple, prefer ExpressionProjection when the value can be expressed.
  */
 class UDProjection : public Projection {
 public:
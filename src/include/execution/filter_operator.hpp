@@ -21,10 +21,20 @@ public:
 
     ~FilterOperator() = default;
 
-    OperatorState Next(Chunk &output_chunk) override;
+    OperatorState Next(DataChunk &output_chunk) override;
 
     std::string BindTableName() override { return child_operators_[0]->BindTableName(); }
 
+    void BindForUpdate() override { child_operators_[0]->BindForUpdate(); }
+
+    bool IsStreaming() const override { return true; }
+
+    void ExecuteChunk(DataChunk &chunk) const override;
+
+    bool PushRuntimeFilter(const std::string &column_name, const std::shared_ptr<const BloomFilter> &filter) override {
+        return child_operators_[0]->PushRuntimeFilter(column_name, filter);
+    }
+
 private:
     void SelfInit() override;
 
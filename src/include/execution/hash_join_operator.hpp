@@ -1,9 +1,11 @@
 #pragma once
 
+#include "execution/join_hash_table.hpp"
+#include "execution/memory_budget.hpp"
 #include "execution/operator.hpp"
+#include "execution/spill_file.hpp"
 
 #include <string>
-#include <unordered_map>
 
 namespace babydb {
 
@@ -11,6 +13,11 @@ namespace babydb {
  * Hash Join Operator
  * We only support equavilant join on one column.
  * The output schema is just the union of the input's schema.
+ * Every probe chunk is joined at once: the matches are found in batches, then each output column is gathered.
+ * A build side exceeding the memory budget of the query makes it a hybrid hash join: both sides are partitioned
+ * by the hash of the key, the build partitions that fit stay in memory and the probe rows of the others are
+ * spilled to disk. The spilled partitions are joined one by one after the probe side ended, a partition still
+ * too large for the budget is split again.
  */
 class HashJoinOperator : public Operator {
 public:
@@ -22,29 +29,75 @@ public:
 
     ~HashJoinOperator() override = default;
     
-    OperatorState Next(Chunk &output_chunk) override;
+    OperatorState Next(DataChunk &output_chunk) override;
+    //! Streams the probe side, the build side is a pipeline breaker.
+    bool IsStreaming() const override { return true; }
+    //! Builds the hash table.
+    void PrepareStreaming() override;
+
+    void ExecuteChunk(DataChunk &chunk) const override;
+    //! Joins the spilled partitions.
+    bool FinishStreaming(DataChunk &chunk) override;
+    //! Only into the probe side.
+    bool PushRuntimeFilter(const std::string &column_name, const std::shared_ptr<const BloomFilter> &filter) override {
+        return child_operators_[0]->PushRuntimeFilter(column_name, filter);
+    }
 
     void SelfInit() override;
 
     void SelfCheck() override;
+    //! The spilled partitions read back since Init.
+    idx_t SpilledPartitionCount() const {
+        return spilled_partition_count_;
+    }
 
 private:
+    struct SpilledPartition {
+        std::shared_ptr<PartitionedSpill> build;
+
+        std::shared_ptr<PartitionedSpill> probe;
+
+        idx_t partition;
+    };
+
     void BuildHashTable();
+    //! Joins the selected rows of chunk with build_rows_.
+    void ProbeChunk(DataChunk &chunk) const;
+    //! Loads the build rows of a spilled partition into the hash table, or splits the partition if they don't fit.
+    void LoadSpilledPartition(const SpilledPartition &spilled);
+
+    idx_t BuildRowBytes() const;
 
 private:
     std::string probe_column_name_;
 
     std::string build_column_name_;
+    //! Build key -> rows of build_rows_.
+    JoinHashTable hash_table_;
+
+    DataChunk build_rows_;
+
+    bool hash_table_build_{false};
+
+    MemoryReservation reservation_;
+    //! Both nullptr if nothing spilled.
+    std::shared_ptr<PartitionedSpill> build_spill_;
+
+    std::shared_ptr<PartitionedSpill> probe_spill_;
+    //! The partitions of build_spill_ held by hash_table_ while the probe side streams.
+    std::vector<bool> resident_partitions_;
 
-    std::unordered_multimap<data_t, Tuple> hash_table_;
+    std::vector<SpilledPartition> spilled_partitions_;
+    //! The probe rows joined with the hash table right now, once the probe side ended.
+    std::shared_ptr<PartitionedSpill> current_probe_;
 
-    Chunk buffer_;
+    idx_t current_partition_{0};
 
-    idx_t buffer_ptr_;
+    idx_t spilled_partition_count_{0};
 
-    bool probe_child_exhausted_;
+    bool probe_exhausted_{false};
 
-    bool hash_table_build_;
+    bool probing_spilled_{false};
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "execution/operator.hpp"
+
+#include <optional>
+
+namespace babydb {
+
+/**
+ * Increment Operator
+ * Adds a constant to one column of the input rows, which must be rows of an indexed table.
+ * Unlike an update, concurrent increments of a row don't conflict: they are kept as deltas and applied
+ * on the newest version at commit, so the transaction doesn't see its own increments.
+ * With an escrow bound, an increment is refused if the column could leave the bound.
+ */
+class IncrementOperator : public Operator {
+public:
+    IncrementOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
+                      const std::string &column_name, int64_t delta,
+                      const std::optional<EscrowBound> &bound = std::nullopt);
+
+    ~IncrementOperator() override = default;
+
+    OperatorState Next(DataChunk &) override;
+
+    void SelfInit() override {}
+
+    void SelfCheck() override;
+
+private:
+    std::string table_name_;
+
+    std::string column_name_;
+
+    int64_t delta_;
+
+    std::optional<EscrowBound> bound_;
+};
+
+}
@@ -21,7 +21,7 @@ public:
 
     ~InsertOperator() override = default;
 
-    OperatorState Next(Chunk &) override;
+    OperatorState Next(DataChunk &) override;
 
     void SelfInit() override {}
 
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "execution/data_chunk.hpp"
+
+namespace babydb {
+
+class ThreadPool;
+
+/**
+ * Join Hash Table
+ * A flat open addressing table from the build keys to their rows. Every distinct key has one slot, which keeps
+ * the key next to the range of its rows in the row array of the partition, so a probe touches one slot and one
+ * run of rows in the common case, however many rows share a key. A large build side is radix
+ * partitioned by the high bits of the hash first, so the table of each partition fits in L2 and the partitions
+ * are built in parallel. Probes go in batches, the slots of the whole batch are prefetched before any is read.
+ */
+class JoinHashTable {
+public:
+    //! Builds the table over keys, the row of keys[i] is i.
+    void Build(const std::vector<data_t> &keys, ThreadPool &thread_pool);
+    //! For every match of a selected row of chunk, appends its position to probe_positions and the build row to
+    //! build_rows.
+    void Probe(const DataChunk &chunk, idx_t key_column, std::vector<idx_t> &probe_positions,
+               std::vector<idx_t> &build_rows) const;
+
+    void Clear() {
+        partitions_.clear();
+        radix_bits_ = 0;
+    }
+    //! The number of distinct build keys.
+    idx_t KeyCount() const {
+        idx_t key_count = 0;
+        for (auto &partition : partitions_) {
+            key_count += partition.key_count;
+        }
+        return key_count;
+    }
+
+private:
+    struct Entry {
+        data_t key;
+
+        idx_t row;
+    };
+    //! count = 0 marks an empty slot.
+    struct Slot {
+        data_t key;
+        //! The rows of the key are rows[begin, begin + count) of the partition.
+        idx_t begin;
+
+        idx_t count;
+    };
+
+    struct Partition {
+        std::vector<Slot> slots;
+        //! Grouped by key, in row order within a key.
+        std::vector<idx_t> rows;
+
+        idx_t mask;
+
+        idx_t key_count{0};
+    };
+
+    static constexpr idx_t PARTITION_TARGET_ROWS = 32768;
+
+    static constexpr idx_t MAX_RADIX_BITS = 10;
+
+    static constexpr idx_t PROBE_BATCH_SIZE = 16;
+
+    idx_t PartitionOf(uint64_t hash) const {
+        return radix_bits_ == 0 ? 0 : hash >> (64 - radix_bits_);
+    }
+
+    static void BuildPartition(Partition &partition, const Entry *entries, idx_t count);
+
+private:
+    std::vector<Partition> partitions_;
+
+    idx_t radix_bits_{0};
+};
+
+}
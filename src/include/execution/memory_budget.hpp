@@ -0,0 +1,106 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+
+#include <atomic>
+#include <memory>
+
+namespace babydb {
+
+/**
+ * Memory Budget
+ * The memory a query may hold in its pipeline breakers, shared by all operators of the query.
+ * A limit of 0 means no limit.
+ */
+class MemoryBudget {
+public:
+    explicit MemoryBudget(idx_t limit) : limit_(limit) {}
+
+    //! Returns false and reserves nothing if bytes don't fit.
+    bool TryReserve(idx_t bytes) {
+        auto reserved = reserved_.fetch_add(bytes) + bytes;
+        if (limit_ != 0 && reserved > limit_) {
+            reserved_.fetch_sub(bytes);
+            return false;
+        }
+        return true;
+    }
+
+    //! Reserves bytes even beyond the limit, for memory that is used anyway.
+    void Reserve(idx_t bytes) {
+        reserved_.fetch_add(bytes);
+    }
+
+    void Release(idx_t bytes) {
+        reserved_.fetch_sub(bytes);
+    }
+
+    idx_t Reserved() const {
+        return reserved_.load();
+    }
+
+    idx_t Limit() const {
+        return limit_;
+    }
+
+private:
+    const idx_t limit_;
+
+    std::atomic<idx_t> reserved_{0};
+};
+
+//! The part of a budget held by one operator (or one worker of it), given back on destruction.
+class MemoryReservation {
+public:
+    explicit MemoryReservation(std::shared_ptr<MemoryBudget> budget) : budget_(std::move(budget)) {}
+
+    ~MemoryReservation() {
+        Resize(0);
+    }
+
+    MemoryReservation(MemoryReservation &&other) noexcept : budget_(std::move(other.budget_)), bytes_(other.bytes_) {
+        other.bytes_ = 0;
+    }
+
+    MemoryReservation(const MemoryReservation &) = delete;
+
+    MemoryReservation& operator=(const MemoryReservation &) = delete;
+    //! Returns false and keeps the old size if the budget can't grow to bytes. Without a budget it always grows.
+    bool Resize(idx_t bytes) {
+        if (budget_ == nullptr) {
+            return true;
+        }
+        if (bytes > bytes_ && !budget_->TryReserve(bytes - bytes_)) {
+            return false;
+        }
+        if (bytes < bytes_) {
+            budget_->Release(bytes_ - bytes);
+        }
+        bytes_ = bytes;
+        return true;
+    }
+
+    //! Resizes even beyond the budget, so the other users of the budget see the memory in use.
+    void ForceResize(idx_t bytes) {
+        if (budget_ == nullptr) {
+            return;
+        }
+        if (bytes > bytes_) {
+            budget_->Reserve(bytes - bytes_);
+        } else {
+            budget_->Release(bytes_ - bytes);
+        }
+        bytes_ = bytes;
+    }
+
+    idx_t Size() const {
+        return bytes_;
+    }
+
+private:
+    std::shared_ptr<MemoryBudget> budget_;
+
+    idx_t bytes_{0};
+};
+
+}
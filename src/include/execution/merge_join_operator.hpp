@@ -0,0 +1,76 @@
+#pragma once
+
+#include "execution/operator.hpp"
+
+#include <string>
+
+namespace babydb {
+
+/**
+ * Merge Join Operator
+ * Equal join on one column of two inputs sorted ascending by it, e.g. index scans on the join keys or sorts.
+ * The output schema is the union of the input's schema, the output is sorted by the key as well.
+ * Both inputs are read once in step, only the rows of the right input sharing the current key are buffered,
+ * so a unique right side needs O(1) memory. Throws if an input turns out not to be sorted.
+ */
+class MergeJoinOperator : public Operator {
+public:
+    MergeJoinOperator(const ExecutionContext &exec_ctx,
+                      const std::shared_ptr<Operator> &left_child_operator,
+                      const std::shared_ptr<Operator> &right_child_operator,
+                      const std::string &left_column_name,
+                      const std::string &right_column_name);
+
+    ~MergeJoinOperator() override = default;
+
+    OperatorState Next(DataChunk &output_chunk) override;
+
+    void SelfInit() override;
+
+    void SelfCheck() override;
+
+private:
+    //! The current row of a child, chunks are pulled on demand.
+    struct Cursor {
+        DataChunk chunk;
+
+        idx_t position{0};
+
+        idx_t key_attr{0};
+
+        data_t last_key{0};
+
+        OperatorState child_state{HAVE_MORE_OUTPUT};
+
+        bool exhausted{false};
+    };
+    //! Moves to the next row, and pulls chunks until one has it.
+    void Advance(Cursor &cursor, Operator &child);
+    //! Pulls the first chunk with a row.
+    void Fill(Cursor &cursor, Operator &child);
+
+    data_t Key(const Cursor &cursor) const {
+        return cursor.chunk.GetValue(cursor.key_attr, cursor.position);
+    }
+
+private:
+    std::string left_column_name_;
+
+    std::string right_column_name_;
+
+    Cursor left_;
+
+    Cursor right_;
+    //! The right rows with key run_key_, joined with every left row of the key.
+    DataChunk run_;
+
+    data_t run_key_{0};
+
+    bool run_active_{false};
+    //! The next row of run_ to join with the current left row.
+    idx_t run_position_{0};
+
+    bool started_{false};
+};
+
+}
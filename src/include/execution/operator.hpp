@@ -3,6 +3,8 @@
 #include "common/config.hpp"
 #include "common/macro.hpp"
 #include "common/typedefs.hpp"
+#include "execution/bloom_filter.hpp"
+#include "execution/data_chunk.hpp"
 #include "execution/execution_context.hpp"
 
 #include <algorithm>
@@ -10,8 +12,6 @@
 
 namespace babydb {
 
-typedef std::vector<std::pair<Tuple, idx_t>> Chunk;
-
 enum OperatorState {
     HAVE_MORE_OUTPUT,
     EXHAUSETED
@@ -36,12 +36,13 @@ public:
         }
     }
 
-    virtual OperatorState Next(Chunk &output_chunk) = 0;
+    virtual OperatorState Next(DataChunk &output_chunk) = 0;
 
     void Init() {
         for (auto &child_operator : child_operators_) {
             child_operator->Init();
         }
+        runtime_filters_.clear();
         SelfInit();
     }
 
@@ -49,6 +50,10 @@ public:
         return output_schema_;
     }
 
+    Operator* GetChildOperator(idx_t child_id) {
+        return child_operators_[child_id].get();
+    }
+
     void Check() {
         for (auto &child_operator : child_operators_) {
             child_operator->Check();
@@ -58,6 +63,28 @@ public:
     }
 
     virtual std::string BindTableName() { return INVALID_NAME; }
+    //! The rows read are updated next. A scan taking row locks takes exclusive ones then.
+    virtual void BindForUpdate() {}
+    //! A morsel source splits its output into morsels, which the workers of a pipeline scan in parallel.
+    virtual bool IsMorselSource() const { return false; }
+    //! Called once before the morsels are scanned, returns their number.
+    virtual idx_t PrepareMorsels() { throw std::logic_error("Not a morsel source"); }
+    //! Thread safe.
+    virtual void ScanMorsel(idx_t morsel, DataChunk &output_chunk) const { throw std::logic_error("Not a morsel source"); }
+    //! A streaming operator transforms every chunk of its first child on its own, so it can run in a pipeline.
+    virtual bool IsStreaming() const { return false; }
+    //! Called once before a pipeline runs the operator, e.g. to build the hash table of a join.
+    virtual void PrepareStreaming() {}
+    //! Replaces a chunk of the first child with the output for it. Thread safe.
+    virtual void ExecuteChunk(DataChunk &chunk) const { throw std::logic_error("Not a streaming operator"); }
+    //! Called after the last ExecuteChunk, returns the output held back until the input ended one chunk per call,
+    //! e.g. the joins of spilled partitions. Returns false once there is none.
+    virtual bool FinishStreaming(DataChunk &chunk) { return false; }
+    //! Pushes a filter on an output column down to the source producing the column, which drops the rows failing it
+    //! before materializing them. Returns false if no source takes it. Only before the source is read.
+    virtual bool PushRuntimeFilter(const std::string &column_name, const std::shared_ptr<const BloomFilter> &filter) {
+        return false;
+    }
 
 protected:
     virtual void SelfInit() = 0;
@@ -74,12 +101,42 @@ protected:
         }
     }
 
+    //! For sources: takes a runtime filter on an own output column.
+    bool AddRuntimeFilter(const std::string &column_name, const std::shared_ptr<const BloomFilter> &filter) {
+        auto column = std::find(output_schema_.begin(), output_schema_.end(), column_name);
+        if (column == output_schema_.end()) {
+            return false;
+        }
+        runtime_filters_.emplace_back(column - output_schema_.begin(), filter);
+        return true;
+    }
+    //! For sources: the output column i of the row is tuple[attrs[i]].
+    bool PassesRuntimeFilters(const Tuple &tuple, const std::vector<idx_t> &attrs) const {
+        for (auto &[column, filter] : runtime_filters_) {
+            if (!filter->MayContain(tuple[attrs[column]])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    //! For sources whose output row is the tuple.
+    bool PassesRuntimeFilters(const Tuple &tuple) const {
+        for (auto &[column, filter] : runtime_filters_) {
+            if (!filter->MayContain(tuple[column])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
 protected:
     ExecutionContext exec_ctx_;
 
     std::vector<std::shared_ptr<Operator>> child_operators_;
 
     Schema output_schema_;
+    //! Pushed into a source: output column -> filter. Cleared by Init.
+    std::vector<std::pair<idx_t, std::shared_ptr<const BloomFilter>>> runtime_filters_;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "execution/operator.hpp"
+
+#include <functional>
+#include <optional>
+
+namespace babydb {
+
+/**
+ * Pipeline
+ * A morsel source followed by streaming operators, compiled from an operator tree by following the first children
+ * down from its root. The workers of the thread pool claim one morsel at a time and push it through every operator,
+ * so the rows of a morsel stay in the cache of one core. The sink gets each chunk with the slot of the worker,
+ * a pipeline breaker keeps worker local state in the slots and merges it after Run.
+ */
+class Pipeline {
+public:
+    //! Returns nullopt if root isn't a chain of streaming operators over a morsel source.
+    static std::optional<Pipeline> Compile(Operator &root);
+    //! Slots are in [0, SlotCount).
+    static idx_t SlotCount(const ThreadPool &thread_pool);
+    //! Calls sink(slot, morsel, chunk) for the output of every morsel and returns the number of chunks. The output
+    //! operators hold back until the end follows the morsels, as chunks of slot 0 numbered after the last morsel.
+    //! The sink is called concurrently, but never twice at once for the same slot.
+    idx_t Run(ThreadPool &thread_pool, const std::function<void(idx_t, idx_t, DataChunk&)> &sink);
+
+private:
+    Pipeline(Operator &source, std::vector<Operator*> &&operators) : source_(&source), operators_(std::move(operators)) {}
+
+private:
+    Operator *source_;
+    //! From the source upwards.
+    std::vector<Operator*> operators_;
+};
+
+//! Runs root after Check() and Init(), and calls sink(slot, chunk_id, chunk) for every output chunk, in parallel as
+//! Pipeline::Run if root compiles. Otherwise the calling thread pulls the chunks with slot 0. Returns the number of
+//! chunks, chunk ids are in [0, count).
+idx_t ExecuteStreaming(Operator &root, ThreadPool &thread_pool,
+                       const std::function<void(idx_t, idx_t, DataChunk&)> &sink);
+//! Runs root after Check() and Init(), and returns its output. A pipeline runs in parallel, the chunks keep the order
+//! of the morsels. Any other root is pulled by the calling thread, but its pipeline breakers still run in parallel.
+std::vector<DataChunk> ExecuteParallel(Operator &root, ThreadPool &thread_pool);
+
+}
@@ -24,10 +24,18 @@ public:
 
     ~ProjectionOperator() = default;
 
-    OperatorState Next(Chunk &output_chunk) override;
+    OperatorState Next(DataChunk &output_chunk) override;
 
     std::string BindTableName() override { return child_operators_[0]->BindTableName(); }
 
+    void BindForUpdate() override { child_operators_[0]->BindForUpdate(); }
+
+    bool IsStreaming() const override { return true; }
+
+    void ExecuteChunk(DataChunk &chunk) const override;
+    //! Only through a unit projection, it keeps the values.
+    bool PushRuntimeFilter(const std::string &column_name, const std::shared_ptr<const BloomFilter> &filter) override;
+
 private:
     void SelfInit() override;
 
@@ -18,7 +18,7 @@ public:
 
     ~RangeIndexScanOperator() override = default;
 
-    OperatorState Next(Chunk &output_chunk) override;
+    OperatorState Next(DataChunk &output_chunk) override;
 
     void SelfInit() override;
 
@@ -26,6 +26,26 @@ public:
 
     std::string BindTableName() override { return table_name_; }
 
+    void BindForUpdate() override { for_update_ = true; }
+
+    bool IsMorselSource() const override { return true; }
+
+    idx_t PrepareMorsels() override;
+
+    void ScanMorsel(idx_t morsel, DataChunk &output_chunk) const override;
+
+    bool PushRuntimeFilter(const std::string &column_name, const std::shared_ptr<const BloomFilter> &filter) override {
+        return AddRuntimeFilter(column_name, filter);
+    }
+
+private:
+    //! Finds the rows in the range once, the chunks then read them.
+    void ScanRows();
+    //! Locks the rows found and reads their newest committed versions instead of the snapshot.
+    void LockRows();
+    //! Reads the found rows [begin, end) into output_chunk, under a read guard of the table.
+    void ReadRows(idx_t begin, idx_t end, DataChunk &output_chunk) const;
+
 private:
     std::string table_name_;
 
@@ -36,10 +56,17 @@ private:
     RangeInfo range_;
 
     std::vector<idx_t> row_ids_;
+    //! Parallel to row_ids_, empty if the index keeps no versions.
+    std::vector<VersionSkipList*> row_lists_;
+    //! Parallel to row_ids_ if the rows were locked, the lock ts each row was read at. Empty if every row was read
+    //! at the read ts of the txn.
+    std::vector<idx_t> row_read_ts_;
 
-    std::vector<idx_t>::iterator next_ite_;
+    idx_t next_row_{0};
 
     bool results_scanned_{false};
+
+    bool for_update_{false};
 };
 
 }
\ No newline at end of file
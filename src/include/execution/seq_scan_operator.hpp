@@ -24,7 +24,7 @@ public:
 
     ~SeqScanOperator() override = default;
 
-    OperatorState Next(Chunk &output_chunk) override;
+    OperatorState Next(DataChunk &output_chunk) override;
 
     void SelfInit() override;
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "execution/memory_budget.hpp"
+#include "execution/operator.hpp"
+#include "execution/spill_file.hpp"
+
+namespace babydb {
+
+struct SortKey {
+    std::string column_name;
+
+    bool descending{false};
+};
+
+//! A key whose unsigned order is the order of the sort.
+inline data_t NormalizeSortKey(data_t value, bool descending) {
+    return descending ? ~value : value;
+}
+
+class RunMerger;
+
+/**
+ * Sort Operator
+ * Orders the rows by several keys, each ascending or descending. The output schema is the same as the input.
+ * The rows are sorted in memory by an LSD radix sort on the normalized keys, from the last key to the first.
+ * The passes over bytes every row shares are skipped, so small keys cost few passes. Past the memory budget of the
+ * query the sorted rows are spilled as a run, and the runs are merged by a loser tree at the end. If there are
+ * more runs than the budget can hold a block of, they are merged in several passes.
+ * Equal keys keep the order of the input only when the child isn't a parallel pipeline.
+ */
+class SortOperator : public Operator {
+public:
+    SortOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
+                 const std::vector<SortKey> &sort_keys);
+
+    ~SortOperator() override;
+
+    OperatorState Next(DataChunk &output_chunk) override;
+
+    void SelfInit() override;
+
+    void SelfCheck() override;
+
+private:
+    void SortInput();
+    //! Sorts rows_ into sorted_rows_.
+    void SortRows();
+    //! Moves the sorted rows_ into a run on disk.
+    void SpillRun();
+    //! Merges the runs until the budget holds a block of each.
+    void MergeRuns();
+
+    idx_t RowBytes() const;
+
+private:
+    std::vector<SortKey> sort_keys_;
+
+    std::vector<idx_t> sort_attrs_;
+
+    DataChunk rows_;
+    //! rows_ in the order of the sort.
+    std::vector<idx_t> sorted_rows_;
+
+    idx_t output_position_{0};
+
+    MemoryReservation reservation_;
+
+    std::vector<std::unique_ptr<SpillFile>> runs_;
+    //! Only if runs were spilled.
+    std::unique_ptr<RunMerger> merger_;
+
+    bool input_sorted_{false};
+};
+
+}
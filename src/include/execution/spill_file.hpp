@@ -0,0 +1,101 @@
+#pragma once
+
+#include "common/typedefs.hpp"
+#include "execution/data_chunk.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+namespace babydb {
+
+/**
+ * Spill File
+ * An anonymous temp file of rows, written once and then read once, both sequentially. The rows are buffered
+ * and go to the file in columnar blocks, a read returns one block. The file is unlinked when it is created,
+ * so it never outlives the process.
+ */
+class SpillFile {
+public:
+    SpillFile(idx_t column_count, const std::string &directory);
+
+    ~SpillFile();
+
+    SpillFile(const SpillFile &) = delete;
+
+    SpillFile& operator=(const SpillFile &) = delete;
+    //! Appends the selected rows of chunk.
+    void Append(const DataChunk &chunk);
+    //! Ends the writes, the reads start at the first row.
+    void FinishWrite();
+    //! Reads the next block into chunk, returns false after the last one.
+    bool Read(DataChunk &chunk);
+
+    idx_t RowCount() const {
+        return row_count_;
+    }
+
+    static constexpr idx_t BLOCK_ROWS = 4096;
+
+private:
+    void Flush();
+
+private:
+    const idx_t column_count_;
+
+    const std::string directory_;
+    //! Created by the first flush.
+    std::FILE *file_{nullptr};
+
+    DataChunk buffer_;
+
+    idx_t row_count_{0};
+};
+
+/**
+ * Partitioned Spill
+ * Rows scattered by the hash of their keys into SpillFiles. Every level of a recursive partitioning salts the
+ * hash differently, so a partition that is still too large splits again at the next level.
+ */
+class PartitionedSpill {
+public:
+    PartitionedSpill(idx_t column_count, idx_t level, const std::string &directory);
+    //! Appends the selected rows of chunk, hashes has one hash per position. Thread safe.
+    void Append(const DataChunk &chunk, const std::vector<uint64_t> &hashes);
+    //! Appends the selected rows of chunk by the hash of the key column. Thread safe.
+    void Append(const DataChunk &chunk, idx_t key_attr);
+
+    void FinishWrite();
+
+    idx_t PartitionOf(uint64_t hash) const;
+
+    SpillFile& Partition(idx_t partition) {
+        return *partitions_[partition];
+    }
+    //! Deletes the file of a partition that was read.
+    void ReleasePartition(idx_t partition) {
+        partitions_[partition].reset();
+    }
+
+    idx_t Level() const {
+        return level_;
+    }
+
+    static constexpr idx_t FANOUT_BITS = 4;
+
+    static constexpr idx_t FANOUT = idx_t(1) << FANOUT_BITS;
+    //! A partition at the deepest level is processed in memory even beyond the budget. Its keys share the hash bits
+    //! of every level, further splits may not make it smaller, e.g. if most rows have one key.
+    static constexpr idx_t MAX_LEVEL = 3;
+
+private:
+    const idx_t column_count_;
+
+    const idx_t level_;
+
+    std::vector<std::unique_ptr<SpillFile>> partitions_;
+
+    std::mutex latch_;
+};
+
+}
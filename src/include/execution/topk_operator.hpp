@@ -0,0 +1,73 @@
+#pragma once
+
+#include "execution/operator.hpp"
+#include "execution/sort_operator.hpp"
+
+namespace babydb {
+
+/**
+ * TopK Operator
+ * The first limit rows in the order of the sort keys, i.e. ORDER BY ... LIMIT limit, sorted.
+ * The output schema is the same as the input.
+ * Every worker keeps its best rows in a max-heap of size limit, whose top is the worst of them: a row only enters
+ * by replacing the top, O(n log limit) in total and O(limit) memory. The heaps are combined at the end.
+ */
+class TopKOperator : public Operator {
+public:
+    TopKOperator(const ExecutionContext &exec_ctx, const std::shared_ptr<Operator> &child_operator,
+                 const std::vector<SortKey> &sort_keys, idx_t limit);
+
+    ~TopKOperator() override = default;
+
+    OperatorState Next(DataChunk &output_chunk) override;
+
+    void SelfInit() override;
+
+    void SelfCheck() override;
+
+private:
+    struct Entry {
+        //! Normalized sort keys.
+        Tuple keys;
+
+        Tuple row;
+    };
+
+    class Heap {
+    public:
+        explicit Heap(idx_t limit) : limit_(limit) {}
+        //! Takes the rows of chunk that beat the top.
+        void AddChunk(const DataChunk &chunk, const std::vector<idx_t> &sort_attrs,
+                      const std::vector<SortKey> &sort_keys);
+
+        void Push(Entry &&entry);
+        //! Leaves the heap empty.
+        std::vector<Entry> TakeSorted();
+
+    private:
+        static bool Less(const Entry &left, const Entry &right) {
+            return left.keys < right.keys;
+        }
+
+        const idx_t limit_;
+
+        std::vector<Entry> entries_;
+        //! Reused for the keys of every row.
+        Tuple keys_;
+    };
+
+    void BuildHeap();
+
+private:
+    std::vector<SortKey> sort_keys_;
+
+    idx_t limit_;
+
+    std::vector<Entry> results_;
+
+    idx_t output_position_{0};
+
+    bool heap_build_{false};
+};
+
+}
@@ -22,7 +22,7 @@ public:
 
     ~UpdateOperator() override = default;
 
-    OperatorState Next(Chunk &) override;
+    OperatorState Next(DataChunk &) override;
 
     void SelfInit() override {}
 
@@ -18,7 +18,17 @@ public:
 
     void SelfCheck() override;
 
-    OperatorState Next(Chunk &output_chunk) override;
+    OperatorState Next(DataChunk &output_chunk) override;
+
+    bool IsMorselSource() const override { return true; }
+
+    idx_t PrepareMorsels() override;
+
+    void ScanMorsel(idx_t morsel, DataChunk &output_chunk) const override;
+
+    bool PushRuntimeFilter(const std::string &column_name, const std::shared_ptr<const BloomFilter> &filter) override {
+        return AddRuntimeFilter(column_name, filter);
+    }
 
 private:
     std::vector<Tuple> tuples_;
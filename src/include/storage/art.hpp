@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/typedefs.hpp"
+#include "concurrency/ssi.hpp"
 #include "storage/index.hpp"
 
 #include <memory>
@@ -8,18 +9,40 @@
 namespace babydb {
 
 class ArtTree;
+class ThreadPool;
 
 class ArtIndex : public RangeIndex {
 public:
-    explicit ArtIndex(const std::string &name, Table &table, const std::string &key_name);
+    //! Building on a populated table indexes the last row of every key, using the thread pool.
+    explicit ArtIndex(const std::string &name, Table &table, const std::string &key_name, ThreadPool &thread_pool);
     ~ArtIndex() override;
 
     void InsertEntry(const data_t &key, idx_t row_id, ExecutionContext &exec_ctx) override;
     idx_t LookupKey(const data_t &key, ExecutionContext &exec_ctx) override;
+    VersionSkipList* LookupVersions(const data_t &key) override;
+
+    void CatchUp(Table &table, idx_t first_row) override;
+
+    bool EraseIfEmpty(VersionSkipList *row_list) override;
+
+    bool Versioned() const override {
+        return true;
+    }
     void ScanRange(const RangeInfo &range, std::vector<idx_t> &row_ids, ExecutionContext &exec_ctx) override;
 
+    void ScanRangeWithVersions(const RangeInfo &range, std::vector<idx_t> &row_ids,
+                               std::vector<VersionSkipList*> &row_lists, ExecutionContext &exec_ctx) override;
+
 private:
+    void Scan(const RangeInfo &range, std::vector<idx_t> &row_ids, std::vector<VersionSkipList*> *row_lists,
+              ExecutionContext &exec_ctx);
+
+private:
+    Table &table_;
+
     std::unique_ptr<ArtTree> art_tree_;
+    //! Scanned ranges of SERIALIZABLE transactions.
+    SsiPredicateLocks predicate_locks_;
 };
 
 } // namespace babydb
@@ -13,30 +13,46 @@ namespace babydb {
 class Table;
 class Index;
 
-//! Catalog is not thread-safe. Since it's updated infrequently, when update the catalog,
-//! you should hold the database's latch.
+/**
+ * Catalog
+ * One version of the tables and indexes. A published version is never changed: DDL changes a Clone of the
+ * current version and publishes it, and a transaction keeps the version it started with. The tables and
+ * indexes are shared by the versions, and live until the last version holding them is released.
+ */
 class Catalog {
 public:
     Catalog() = default;
 
     DISALLOW_COPY_AND_MOVE(Catalog);
+    //! A copy to apply a DDL to.
+    std::shared_ptr<Catalog> Clone() const;
 
-    void CreateTable(std::unique_ptr<Table> table);
+    void CreateTable(std::shared_ptr<Table> table);
 
     void DropTable(const std::string &table_name);
 
-    void CreateIndex(std::unique_ptr<Index> index);
+    void CreateIndex(std::shared_ptr<Index> index);
 
     void DropIndex(const std::string &index_name);
 
     Table& FetchTable(const std::string &table_name) const;
 
     Index& FetchIndex(const std::string &index_name) const;
+    //! The index of the table, INVALID_NAME if it has none.
+    std::string GetTableIndex(const std::string &table_name) const;
+
+    std::shared_ptr<Index> GetIndexPtr(const std::string &index_name) const;
 
 private:
-    std::map<std::string, std::unique_ptr<Table>> tables_;
+    struct TableEntry {
+        std::shared_ptr<Table> table;
+        //! Empty string means no index. To simplify, a table can have at most 1 index.
+        std::string index_name;
+    };
+
+    std::map<std::string, TableEntry> tables_;
 
-    std::map<std::string, std::unique_ptr<Index>> indexes_;
+    std::map<std::string, std::shared_ptr<Index>> indexes_;
 };
 
-}
\ No newline at end of file
+}
@@ -4,12 +4,16 @@
 #include "common/macro.hpp"
 #include "storage/table.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 
 namespace babydb {
 
 struct ExecutionContext;
 class Transaction;
+class VersionSkipList;
 
 //! We only support index with the primary key.
 //! Index may be not thread-safe, so you should use indexes with the table guard.
@@ -20,6 +24,9 @@ public:
     const std::string table_name_;
 
     const std::string key_name_;
+    //! The versions an index backfills from a populated table are stamped ts 0, reads older than this ts would see
+    //! newer rows through them. Set before the index is published.
+    idx_t build_ts_{0};
 
 public:
     Index(const std::string &name, Table &table, const std::string &key_name)
@@ -32,6 +39,48 @@ public:
     virtual void InsertEntry(const data_t &key, idx_t row_id, ExecutionContext &exec_ctx) = 0;
     //! Returns INVALID_ID if not found, otherwise returns the row_id
     virtual idx_t LookupKey(const data_t &key, ExecutionContext &exec_ctx) = 0;
+    //! The version list of key, nullptr if the key has none or the index keeps no versions.
+    virtual VersionSkipList* LookupVersions(const data_t &key) {
+        return nullptr;
+    }
+    //! A versioned index keeps the entries of a transaction invisible to others until it commits.
+    virtual bool Versioned() const {
+        return false;
+    }
+    //! Unlinks row_list if it holds no version, so the entry of an aborted insert goes. Returns whether it was
+    //! unlinked, the caller frees it once no transaction can hold it anymore.
+    virtual bool EraseIfEmpty(VersionSkipList *row_list) {
+        return false;
+    }
+    //! Indexes the committed rows appended to the table from first_row on, while the index was built.
+    //! Called before the index is published, so no transaction writes through it yet.
+    virtual void CatchUp(Table &table, idx_t first_row) = 0;
+
+    //! Throws if a read at read_ts can't use the index, see build_ts_.
+    void CheckReadTs(idx_t read_ts) const {
+        if (read_ts < build_ts_) {
+            throw std::logic_error("The index " + name_ + " was built after the read ts.");
+        }
+    }
+
+    //! Registers a transaction that writes through the index, until its rows are appended to the table or
+    //! rolled back. Readers don't register. Throws TaintedException once the index is dropped.
+    void AddWriter();
+
+    void RemoveWriter();
+    //! Refuses new writers, called when the index is dropped.
+    void RefuseWriters();
+    //! Blocks until the writers registered before RefuseWriters are finished.
+    void WaitForWriters();
+
+private:
+    std::atomic<idx_t> active_writers_{0};
+
+    std::atomic<bool> dropped_{false};
+
+    std::mutex writers_latch_;
+
+    std::condition_variable writers_cv_;
 
 friend class Catalog;
 };
@@ -41,6 +90,12 @@ public:
     using Index::Index;
 
     virtual void ScanRange(const RangeInfo &range, std::vector<idx_t> &row_ids, ExecutionContext &exec_ctx) = 0;
+    //! Also returns the version list of every row found, or nothing if the index keeps no versions.
+    virtual void ScanRangeWithVersions(const RangeInfo &range, std::vector<idx_t> &row_ids,
+                                       std::vector<VersionSkipList*> &row_lists, ExecutionContext &exec_ctx) {
+        row_lists.clear();
+        ScanRange(range, row_ids, exec_ctx);
+    }
 };
 
 }
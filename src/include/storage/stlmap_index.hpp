@@ -17,6 +17,8 @@ public:
 
     idx_t LookupKey(const data_t &key, ExecutionContext &exec_ctx) override;
 
+    void CatchUp(Table &table, idx_t first_row) override;
+
     void ScanRange(const RangeInfo &range, std::vector<idx_t> &row_ids, ExecutionContext &exec_ctx) override;
 
 private:
@@ -3,6 +3,7 @@
 #include "common/typedefs.hpp"
 #include "common/macro.hpp"
 
+#include <atomic>
 #include <mutex>
 #include <set>
 #include <string>
@@ -49,18 +50,21 @@ public:
     //! Get the read and write permission to the table.
     WriteTableGuard GetWriteTableGuard();
 
-    const std::string GetIndex() const {
-        return index_name_;
+    //! Transactions lock the rows of the table instead of failing on write conflicts.
+    bool RowLocking() const {
+        return row_locking_.load();
+    }
+
+    void SetRowLocking(bool row_locking) {
+        row_locking_.store(row_locking);
     }
 
 private:
     std::vector<Row> rows_;
-    //! Empty string means no index. To simplify, a table can have at most 1 index.
-    std::string index_name_; 
 
     std::shared_mutex latch_;
 
-friend class Catalog;
+    std::atomic<bool> row_locking_{false};
 };
 
 class ReadTableGuard {
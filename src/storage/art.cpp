@@ -4,6 +4,7 @@
 #include "concurrency/transaction.hpp"
 
 #include "../include/concurrency/version_link.hpp"
+#include "common/thread_pool.hpp"
 
 #include <cassert>
 #include <cstring>
@@ -55,6 +56,8 @@ enum ArtNodeType : uint8_t {
 static const uint32_t MAX_PREFIX_LENGTH = 9;
 static const uint8_t EMPTY_MARKER = 48;
 static const idx_t ART_KEY_LENGTH = 8;
+//! A parallel scan is split into this many tasks per thread, to balance uneven subtrees.
+static const idx_t SCAN_TASKS_PER_THREAD = 4;
 
 typedef uint8_t key_t[ART_KEY_LENGTH];
 
@@ -378,10 +381,12 @@ void insert(TreePointer node, TreePointer* nodeRef, key_t key, uint32_t depth, V
         key_t existingKey;
         if (node.AsData()->key == value->key) {
             try {
-                node.AsData()->insert_uncommitted_list(value->uncommitted->data, value->uncommitted->ts, value->uncommitted->txn_id);
+                Datalist* version = value->uncommitted;
+                node.AsData()->insert_uncommitted_list(version->data, version->ts, version->txn_id);
             }
             catch (TaintedException &e) {
                 delete value;
+                value = node.AsData(); // the conflicting row
                 throw e;
             }
             
@@ -538,6 +543,25 @@ void insertNode256(Node256* node, TreePointer* nodeRef, uint8_t keyByte, TreePoi
     node->child[keyByte] = child;
 }
 
+//! Adds a child under a new key byte, growing the node when it is full.
+void addChild(TreePointer* nodeRef, uint8_t keyByte, TreePointer child) {
+    ArtNode* node = nodeRef->AsPtr();
+    switch (node->type) {
+        case NodeType4:
+            insertNode4(static_cast<Node4*>(node), nodeRef, keyByte, child);
+            break;
+        case NodeType16:
+            insertNode16(static_cast<Node16*>(node), nodeRef, keyByte, child);
+            break;
+        case NodeType48:
+            insertNode48(static_cast<Node48*>(node), nodeRef, keyByte, child);
+            break;
+        case NodeType256:
+            insertNode256(static_cast<Node256*>(node), nodeRef, keyByte, child);
+            break;
+    }
+}
+
 void erase(TreePointer node, TreePointer* nodeRef, key_t key, uint32_t depth);
 void eraseNode4(Node4* node, TreePointer* nodeRef, TreePointer* leafPlace);
 void eraseNode16(Node16* node, TreePointer* nodeRef, TreePointer* leafPlace);
@@ -662,100 +686,103 @@ void eraseNode256(Node256* node, TreePointer* nodeRef, uint8_t keyByte) {
     }
 }
 
-void rangeScan(TreePointer node, key_t lowerKey, key_t upperKey, bool contain_start, bool contain_end,
-               std::vector<babydb::idx_t>& row_ids, uint32_t depth, bool left_sure, bool right_sure, ExecutionContext &exec_ctx) {
-    // P1 TODO: Add your code here
-    // throw std::logic_error("Unimplemented function");
-    if (node.Empty()) {
-        return;
+//! Rows found by a range scan, in key order.
+struct ScanOutput {
+    std::vector<idx_t> row_ids;
+    //! The version list of each row in row_ids, if keep_row_lists.
+    std::vector<VersionSkipList*> row_lists;
+
+    std::vector<VersionSkipList*> read_rows;
+
+    bool keep_row_lists{false};
+    //! Only SERIALIZABLE transactions need read_rows.
+    bool track_reads{false};
+};
+
+//! A subtree that still has to be scanned, with the bounds its keys are already known to satisfy.
+struct ScanTask {
+    TreePointer node;
+    uint32_t depth;
+    bool left_sure;
+    bool right_sure;
+};
+
+bool leafInRange(TreePointer node, key_t lowerKey, key_t upperKey, bool contain_start, bool contain_end,
+                 uint32_t depth, bool left_sure, bool right_sure) {
+    if (left_sure && right_sure) {
+        return true;
     }
-    idx_t ts = exec_ctx.txn_.read_ts_;
-    idx_t txn_id = exec_ctx.txn_.txn_id_;
-    if (node.IsLeaf()) {
-        if (left_sure && right_sure) {
-            idx_t result = node.AsData()->search_list(ts, txn_id);
-            if (result != INVALID_ID) {
-                row_ids.push_back(result);
-                exec_ctx.txn_.AddReadRow(node.AsData());
-            }
-            return;
-        } else {
-            key_t leafKey;
-            loadKey(node.AsData()->key, leafKey);
-            bool strict = false;
-            if (!left_sure) {
-                for (idx_t i = depth; i < ART_KEY_LENGTH; i++) {
-                    if (leafKey[i] < lowerKey[i]) 
-                        return;
-                    if (leafKey[i] > lowerKey[i]) {
-                        strict = true;
-                        break;
-                    }
-                }
-                if (!strict && !contain_start) 
-                    return;
-            }
-            if (!right_sure) {
-                strict = false;
-                for (idx_t i = depth; i < ART_KEY_LENGTH; i++) {
-                    if (leafKey[i] > upperKey[i]) 
-                        return;
-                    if (leafKey[i] < upperKey[i]) {
-                        strict = true;
-                        break;
-                    }
-                }
-                if (!strict && !contain_end) 
-                    return;
+    key_t leafKey;
+    loadKey(node.AsData()->key, leafKey);
+    bool strict = false;
+    if (!left_sure) {
+        for (idx_t i = depth; i < ART_KEY_LENGTH; i++) {
+            if (leafKey[i] < lowerKey[i]) 
+                return false;
+            if (leafKey[i] > lowerKey[i]) {
+                strict = true;
+                break;
             }
-            idx_t result = node.AsData()->search_list(ts, txn_id);
-            if (result != INVALID_ID) {
-                row_ids.push_back(result);
-                exec_ctx.txn_.AddReadRow(node.AsData());
+        }
+        if (!strict && !contain_start) 
+            return false;
+    }
+    if (!right_sure) {
+        strict = false;
+        for (idx_t i = depth; i < ART_KEY_LENGTH; i++) {
+            if (leafKey[i] > upperKey[i]) 
+                return false;
+            if (leafKey[i] < upperKey[i]) {
+                strict = true;
+                break;
             }
-            return;
         }
+        if (!strict && !contain_end) 
+            return false;
     }
-    bool left_now= left_sure;
+    return true;
+}
+
+//! Calls visit(child, depth, left_sure, right_sure) for every child of an inner node that may contain keys
+//! in [lowerKey, upperKey], in increasing key order.
+template <class Visitor>
+void visitChildrenInRange(TreePointer node, key_t lowerKey, key_t upperKey, uint32_t depth,
+                          bool left_sure, bool right_sure, Visitor &&visit) {
+    bool left_now = left_sure;
     bool right_now = right_sure;
     if (node->prefixLength) {
         // check prefix
         for (uint32_t pos = 0; pos < node->prefixLength; pos++) {
-            if (!left_now&& (lowerKey[depth + pos] > node->prefix[pos])) 
+            if (!left_now && (lowerKey[depth + pos] > node->prefix[pos])) 
                 return;
             if (!right_now && (upperKey[depth + pos] < node->prefix[pos])) 
                 return;
-            left_now= left_now|| (lowerKey[depth + pos] < node->prefix[pos]); 
+            left_now = left_now || (lowerKey[depth + pos] < node->prefix[pos]); 
             right_now = right_now || (upperKey[depth + pos] > node->prefix[pos]);
         }
         depth += node->prefixLength;
     }
+    auto visitKey = [&](uint8_t k, TreePointer child) {
+        if (!left_now && k < lowerKey[depth]) 
+            return;
+        if (!right_now && k > upperKey[depth]) 
+            return;
+        bool l = left_now || (k > lowerKey[depth]);
+        bool r = right_now || (k < upperKey[depth]);
+        visit(child, depth + 1, l, r);
+    };
     switch (node->type) {
         case NodeType4: {
             Node4* n = static_cast<Node4*>(node.AsPtr());
             for (int i = 0; i < n->count; i++) {
-                uint8_t k = n->key[i];
-                if (!left_now&& k < lowerKey[depth]) 
-                    continue;
-                if (!right_now && k > upperKey[depth]) 
-                    continue;
-                bool l = left_now|| (k > lowerKey[depth]);
-                bool r = right_now || (k < upperKey[depth]);
-                rangeScan(n->child[i], lowerKey, upperKey, contain_start, contain_end, row_ids, depth + 1, l, r, exec_ctx);
+                visitKey(n->key[i], n->child[i]);
             }
             break;
         }
         case NodeType16: {
             Node16* n = static_cast<Node16*>(node.AsPtr());
             for (int i = 0; i < n->count; i++) {
-                uint8_t storedKey = flipSign(n->key[i]); 
-                if (!left_now&& storedKey < lowerKey[depth]) 
-                    continue;
-                if (!right_now && storedKey > upperKey[depth]) 
-                    continue;
-                bool l = left_now|| (storedKey > lowerKey[depth]);
-                bool r = right_now || (storedKey < upperKey[depth]);
-                rangeScan(n->child[i], lowerKey, upperKey, contain_start, contain_end, row_ids, depth + 1, l, r, exec_ctx);
+                visitKey(flipSign(n->key[i]), n->child[i]);
             }
             break;
         }
@@ -764,14 +791,7 @@ void rangeScan(TreePointer node, key_t lowerKey, key_t upperKey, bool contain_st
             for (int i = 0; i < 256; i++) {
                 int idx = n->childIndex[i];
                 if (idx == EMPTY_MARKER) continue;
-                uint8_t k = static_cast<uint8_t>(i);
-                if (!left_now&& k < lowerKey[depth]) 
-                    continue;
-                if (!right_now && k > upperKey[depth]) 
-                    continue;
-                bool l = left_now|| (k > lowerKey[depth]);
-                bool r = right_now || (k < upperKey[depth]);
-                rangeScan(n->child[idx], lowerKey, upperKey, contain_start, contain_end, row_ids, depth + 1, l, r, exec_ctx);
+                visitKey(static_cast<uint8_t>(i), n->child[idx]);
             }
             break;
         }
@@ -780,14 +800,7 @@ void rangeScan(TreePointer node, key_t lowerKey, key_t upperKey, bool contain_st
             for (int i = 0; i < 256; i++) {
                 TreePointer child = n->child[i];
                 if (child.Empty()) continue;
-                uint8_t k = static_cast<uint8_t>(i);
-                if (!left_now&& k < lowerKey[depth]) 
-                    continue;
-                if (!right_now && k > upperKey[depth])
-                    continue;
-                bool l = left_now|| (k > lowerKey[depth]);
-                bool r = right_now || (k < upperKey[depth]);
-                rangeScan(child, lowerKey, upperKey, contain_start, contain_end, row_ids, depth + 1, l, r, exec_ctx);
+                visitKey(static_cast<uint8_t>(i), child);
             }
             break;
         }
@@ -796,7 +809,62 @@ void rangeScan(TreePointer node, key_t lowerKey, key_t upperKey, bool contain_st
             break;
         }
     }
-    
+}
+
+//! Only touches the tree and `output`, so disjoint subtrees can be scanned by different threads.
+void rangeScan(TreePointer node, key_t lowerKey, key_t upperKey, bool contain_start, bool contain_end,
+               ScanOutput &output, uint32_t depth, bool left_sure, bool right_sure, idx_t ts, idx_t txn_id) {
+    if (node.Empty()) {
+        return;
+    }
+    if (node.IsLeaf()) {
+        if (!leafInRange(node, lowerKey, upperKey, contain_start, contain_end, depth, left_sure, right_sure)) {
+            return;
+        }
+        idx_t result = node.AsData()->search_list(ts, txn_id);
+        if (result != INVALID_ID) {
+            output.row_ids.push_back(result);
+            if (output.keep_row_lists) {
+                output.row_lists.push_back(node.AsData());
+            }
+        }
+        // Keys invisible to the snapshot are read too: their writers are concurrent.
+        if (output.track_reads) {
+            output.read_rows.push_back(node.AsData());
+        }
+        return;
+    }
+    visitChildrenInRange(node, lowerKey, upperKey, depth, left_sure, right_sure,
+        [&](TreePointer child, uint32_t child_depth, bool l, bool r) {
+            rangeScan(child, lowerKey, upperKey, contain_start, contain_end, output, child_depth, l, r, ts, txn_id);
+        });
+}
+
+//! Replaces inner nodes by their children in range, level by level, until there are at least target_count tasks
+//! or only leaves are left. The tasks stay in key order.
+void splitScanTasks(std::vector<ScanTask> &tasks, key_t lowerKey, key_t upperKey, idx_t target_count) {
+    while (tasks.size() < target_count) {
+        std::vector<ScanTask> next_tasks;
+        bool split = false;
+        for (auto &task : tasks) {
+            if (task.node.Empty()) {
+                continue;
+            }
+            if (task.node.IsLeaf()) {
+                next_tasks.push_back(task);
+                continue;
+            }
+            split = true;
+            visitChildrenInRange(task.node, lowerKey, upperKey, task.depth, task.left_sure, task.right_sure,
+                [&](TreePointer child, uint32_t child_depth, bool l, bool r) {
+                    next_tasks.push_back(ScanTask{child, child_depth, l, r});
+                });
+        }
+        tasks.swap(next_tasks);
+        if (!split) {
+            return;
+        }
+    }
 }
 
 void destroy(TreePointer node) {
@@ -853,6 +921,83 @@ void destroy(TreePointer node) {
     }
 }
 
+/**
+ * Builds the tree of a populated table. Keys are partitioned by their first byte that is not shared by all keys,
+ * and every partition becomes an independent subtree built by its own task.
+ * When several rows have the same key, the row appended last wins. Each key gets one version at ts 0,
+ * reads older than the build ts of the index are refused.
+ */
+TreePointer bulkLoad(const std::vector<Row> &rows, idx_t key_attr, ThreadPool &thread_pool) {
+    typedef std::pair<data_t, idx_t> Entry;
+    const idx_t row_count = rows.size();
+    const idx_t part_count = std::min<idx_t>(row_count, thread_pool.ThreadCount() + 1);
+
+    std::vector<data_t> part_min(part_count, static_cast<data_t>(-1));
+    std::vector<data_t> part_max(part_count, 0);
+    thread_pool.ParallelFor(part_count, [&](idx_t part) {
+        for (idx_t row_id = part * row_count / part_count; row_id < (part + 1) * row_count / part_count; row_id++) {
+            auto key = rows[row_id].tuple_.KeyFromTuple(key_attr);
+            part_min[part] = std::min(part_min[part], key);
+            part_max[part] = std::max(part_max[part], key);
+        }
+    });
+    key_t minKey, maxKey;
+    loadKey(*std::min_element(part_min.begin(), part_min.end()), minKey);
+    loadKey(*std::max_element(part_max.begin(), part_max.end()), maxKey);
+    uint32_t depth = 0;
+    while (depth < ART_KEY_LENGTH && minKey[depth] == maxKey[depth]) {
+        depth++;
+    }
+    if (depth == ART_KEY_LENGTH) {
+        auto key = rows.back().tuple_.KeyFromTuple(key_attr);
+        auto row_list = new VersionSkipList(key, nullptr);
+        row_list->insert_list(row_count - 1, 0, INVALID_ID);
+        return TreePointer(row_list, 1);
+    }
+
+    // Every part scatters its rows by the partition byte, so each bucket stays in row order.
+    std::vector<std::vector<std::vector<Entry>>> buckets(part_count, std::vector<std::vector<Entry>>(256));
+    thread_pool.ParallelFor(part_count, [&](idx_t part) {
+        for (idx_t row_id = part * row_count / part_count; row_id < (part + 1) * row_count / part_count; row_id++) {
+            auto key = rows[row_id].tuple_.KeyFromTuple(key_attr);
+            key_t keyBytes;
+            loadKey(key, keyBytes);
+            buckets[part][keyBytes[depth]].emplace_back(key, row_id);
+        }
+    });
+
+    std::vector<TreePointer> subtrees(256);
+    thread_pool.ParallelFor(256, [&](idx_t bucket) {
+        std::vector<Entry> entries;
+        for (auto &part_buckets : buckets) {
+            entries.insert(entries.end(), part_buckets[bucket].begin(), part_buckets[bucket].end());
+        }
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const Entry &a, const Entry &b) { return a.first < b.first; });
+        for (idx_t i = 0; i < entries.size(); i++) {
+            if (i + 1 < entries.size() && entries[i + 1].first == entries[i].first) {
+                continue;
+            }
+            key_t keyBytes;
+            loadKey(entries[i].first, keyBytes);
+            auto row_list = new VersionSkipList(entries[i].first, nullptr);
+            row_list->insert_list(entries[i].second, 0, INVALID_ID);
+            insert(subtrees[bucket], &subtrees[bucket], keyBytes, depth + 1, row_list);
+        }
+    });
+
+    Node4* rootNode = new Node4();
+    rootNode->prefixLength = depth;
+    std::memcpy(rootNode->prefix, minKey, depth);
+    TreePointer root(rootNode);
+    for (idx_t bucket = 0; bucket < 256; bucket++) {
+        if (!subtrees[bucket].Empty()) {
+            addChild(&root, static_cast<uint8_t>(bucket), subtrees[bucket]);
+        }
+    }
+    return root;
+}
+
 } // namespace Art
 
 using namespace Art;
@@ -867,12 +1012,12 @@ public:
     TreePointer root_;
 };
 
-ArtIndex::ArtIndex(const std::string &name, Table &table, const std::string &key_name)
-    : RangeIndex(name, table, key_name), art_tree_(std::make_unique<ArtTree>()) {
+ArtIndex::ArtIndex(const std::string &name, Table &table, const std::string &key_name, ThreadPool &thread_pool)
+    : RangeIndex(name, table, key_name), table_(table), art_tree_(std::make_unique<ArtTree>()) {
     auto read_guard = table.GetReadTableGuard();
     auto &rows = read_guard.Rows();
     if (!rows.empty()) {
-        throw std::logic_error("Index can be only built on an empty table");
+        art_tree_->root_ = bulkLoad(rows, table.schema_.GetKeyAttr(key_name), thread_pool);
     }
 }
 
@@ -880,6 +1025,18 @@ ArtIndex::~ArtIndex() {}
 
 void ArtIndex::InsertEntry(const data_t &key, idx_t row_id, ExecutionContext &exec_ctx) {
     // P1 TODO: Add ts support
+    // Covering an existing key needs no temporary version list.
+    auto existing = LookupVersions(key);
+    if (existing) {
+        try {
+            existing->insert_uncommitted_list(row_id, exec_ctx.txn_.WriteTs(existing), exec_ctx.txn_.txn_id_);
+        } catch (TaintedException &e) {
+            exec_ctx.txn_.SetConflict(existing);
+            throw;
+        }
+        exec_ctx.txn_.AddModifiedRow(existing);
+        return;
+    }
     VersionSkipList* node = new VersionSkipList(key, new Datalist(exec_ctx.txn_.read_ts_, row_id, exec_ctx.txn_.txn_id_));
     /*if (LookupKey(key) != INVALID_ID) {
         throw std::logic_error("duplicated key");
@@ -887,21 +1044,70 @@ void ArtIndex::InsertEntry(const data_t &key, idx_t row_id, ExecutionContext &ex
     key_t keyBytes;
     loadKey(key, keyBytes);
     try {
+        auto new_row_list = node;
         insert(art_tree_->root_, &art_tree_->root_, keyBytes, 0, node);
         exec_ctx.txn_.AddModifiedRow(node);
+        if (node == new_row_list) {
+            exec_ctx.txn_.AddInsertedKey(*this, node, predicate_locks_, key);
+        }
     }
     catch (TaintedException &e) {
-        exec_ctx.txn_.SetTainted();
+        exec_ctx.txn_.SetConflict(node);
         throw e;
     }
 }
 
+bool ArtIndex::EraseIfEmpty(VersionSkipList *row_list) {
+    // Claims go through the index under the write latch, so the list stays empty until it is unlinked.
+    auto write_guard = table_.GetWriteTableGuard();
+    if (!row_list->is_empty() || LookupVersions(row_list->key) != row_list) {
+        return false;
+    }
+    key_t keyBytes;
+    loadKey(row_list->key, keyBytes);
+    erase(art_tree_->root_, &art_tree_->root_, keyBytes, 0);
+    return true;
+}
+
+void ArtIndex::CatchUp(Table &table, idx_t first_row) {
+    auto read_guard = table.GetReadTableGuard();
+    auto &rows = read_guard.Rows();
+    auto key_attr = table.schema_.GetKeyAttr(key_name_);
+    // Like the bulk load, the last row of every key becomes its only version.
+    for (idx_t row_id = first_row; row_id < rows.size(); row_id++) {
+        auto key = rows[row_id].tuple_.KeyFromTuple(key_attr);
+        auto row_list = LookupVersions(key);
+        if (!row_list) {
+            row_list = new VersionSkipList(key, nullptr);
+            row_list->insert_list(row_id, 0, INVALID_ID);
+            key_t keyBytes;
+            loadKey(key, keyBytes);
+            insert(art_tree_->root_, &art_tree_->root_, keyBytes, 0, row_list);
+        } else if (row_list->newest.load()->data < row_id) {
+            // The bulk load may have seen the row already.
+            row_list->insert_list(row_id, 0, INVALID_ID);
+        }
+    }
+}
+
+VersionSkipList* ArtIndex::LookupVersions(const data_t &key) {
+    key_t keyBytes;
+    loadKey(key, keyBytes);
+    TreePointer leaf = lookup(art_tree_->root_, keyBytes, 0);
+    if (leaf.Empty() || !leaf.IsLeaf()) {
+        return nullptr;
+    }
+    return leaf.AsData();
+}
+
 idx_t ArtIndex::LookupKey(const data_t &key, ExecutionContext &exec_ctx) {
     // P1 TODO: This version returns the original key, change it to return the rowid & Add ts support
+    CheckReadTs(exec_ctx.txn_.read_ts_);
     key_t keyBytes;
     loadKey(key, keyBytes);
     TreePointer leaf = lookup(art_tree_->root_, keyBytes, 0);
     if (leaf.Empty() || !leaf.IsLeaf()) {
+        exec_ctx.txn_.AddReadRange(predicate_locks_, RangeInfo{key, key});
         return INVALID_ID;
     }
     exec_ctx.txn_.AddReadRow(leaf.AsData());
@@ -909,13 +1115,57 @@ idx_t ArtIndex::LookupKey(const data_t &key, ExecutionContext &exec_ctx) {
 }
 
 void ArtIndex::ScanRange(const RangeInfo &range, std::vector<idx_t> &row_ids, ExecutionContext &exec_ctx) {
-    // P1 TODO: Implement rangeScan & Add ts support (you can change the parameters for rangeScan)
+    Scan(range, row_ids, nullptr, exec_ctx);
+}
+
+void ArtIndex::ScanRangeWithVersions(const RangeInfo &range, std::vector<idx_t> &row_ids,
+                                     std::vector<VersionSkipList*> &row_lists, ExecutionContext &exec_ctx) {
+    Scan(range, row_ids, &row_lists, exec_ctx);
+}
+
+void ArtIndex::Scan(const RangeInfo &range, std::vector<idx_t> &row_ids, std::vector<VersionSkipList*> *row_lists,
+                    ExecutionContext &exec_ctx) {
     row_ids.clear();
+    if (row_lists) {
+        row_lists->clear();
+    }
     key_t lowerKey, upperKey;
     loadKey(range.start, lowerKey);
     loadKey(range.end, upperKey);
 
-    rangeScan(art_tree_->root_, lowerKey, upperKey, range.contain_start, range.contain_end, row_ids, 0, false, false, exec_ctx);
+    auto &txn = exec_ctx.txn_;
+    CheckReadTs(txn.read_ts_);
+    auto &thread_pool = exec_ctx.thread_pool_;
+    std::vector<ScanTask> tasks{ScanTask{art_tree_->root_, 0, false, false}};
+    // Point lookups are not worth splitting.
+    if (thread_pool.ThreadCount() > 0 && range.start != range.end) {
+        splitScanTasks(tasks, lowerKey, upperKey, SCAN_TASKS_PER_THREAD * (thread_pool.ThreadCount() + 1));
+    }
+    // Each group scans a contiguous run of subtrees, so concatenating the outputs keeps the key order.
+    const idx_t group_count = std::min<idx_t>(tasks.size(), SCAN_TASKS_PER_THREAD * (thread_pool.ThreadCount() + 1));
+    std::vector<ScanOutput> outputs(group_count);
+    for (auto &output : outputs) {
+        output.track_reads = txn.TracksReads();
+        output.keep_row_lists = row_lists != nullptr;
+    }
+    // Registered before the scan: an insert into the range either sees it or is seen by the scan.
+    txn.AddReadRange(predicate_locks_, range);
+    thread_pool.ParallelFor(group_count, [&](idx_t group) {
+        for (idx_t i = group * tasks.size() / group_count; i < (group + 1) * tasks.size() / group_count; i++) {
+            auto &task = tasks[i];
+            rangeScan(task.node, lowerKey, upperKey, range.contain_start, range.contain_end, outputs[group],
+                      task.depth, task.left_sure, task.right_sure, txn.read_ts_, txn.txn_id_);
+        }
+    });
+    for (auto &output : outputs) {
+        row_ids.insert(row_ids.end(), output.row_ids.begin(), output.row_ids.end());
+        if (row_lists) {
+            row_lists->insert(row_lists->end(), output.row_lists.begin(), output.row_lists.end());
+        }
+        for (auto row_list : output.read_rows) {
+            txn.AddReadRow(row_list);
+        }
+    }
 }
 
 } // namespace babydb
@@ -7,11 +7,19 @@
 
 namespace babydb {
 
-void Catalog::CreateTable(std::unique_ptr<Table> table) {
+std::shared_ptr<Catalog> Catalog::Clone() const {
+    auto result = std::make_shared<Catalog>();
+    result->tables_ = tables_;
+    result->indexes_ = indexes_;
+    return result;
+}
+
+void Catalog::CreateTable(std::shared_ptr<Table> table) {
     if (tables_.find(table->name_) != tables_.end()) {
         throw std::logic_error("CREATE TABLE: table already exists");
     }
-    tables_.insert(std::make_pair(table->name_, std::move(table)));
+    auto table_name = table->name_;
+    tables_.insert(std::make_pair(table_name, TableEntry{std::move(table), INVALID_NAME}));
 }
 
 void Catalog::DropTable(const std::string &table_name) {
@@ -19,13 +27,13 @@ void Catalog::DropTable(const std::string &table_name) {
     if (position == tables_.end()) {
         throw std::logic_error("DROP TABLE: table does not exist");
     }
-    if (position->second->index_name_ != INVALID_NAME) {
-        indexes_.erase(position->second->index_name_);
+    if (position->second.index_name != INVALID_NAME) {
+        indexes_.erase(position->second.index_name);
     }
     tables_.erase(position);
 }
 
-void Catalog::CreateIndex(std::unique_ptr<Index> index) {
+void Catalog::CreateIndex(std::shared_ptr<Index> index) {
     if (indexes_.find(index->name_) != indexes_.end()) {
         throw std::logic_error("CREATE INDEX: index already exists");
     }
@@ -33,11 +41,12 @@ void Catalog::CreateIndex(std::unique_ptr<Index> index) {
     if (table_position == tables_.end()) {
         throw std::logic_error("CREATE INDEX: table does not exist");
     }
-    if (table_position->second->index_name_ != INVALID_NAME) {
+    if (table_position->second.index_name != INVALID_NAME) {
         throw std::logic_error("CREATE INDEX: table already has an index");
     }
-    table_position->second->index_name_ = index->name_;
-    indexes_.insert(std::make_pair(index->name_, std::move(index)));
+    table_position->second.index_name = index->name_;
+    auto index_name = index->name_;
+    indexes_.insert(std::make_pair(index_name, std::move(index)));
 }
 
 void Catalog::DropIndex(const std::string &index_name) {
@@ -46,7 +55,7 @@ void Catalog::DropIndex(const std::string &index_name) {
         throw std::logic_error("DROP INDEX: index does not exist");
     }
     auto table_position = tables_.find(position->second->table_name_);
-    table_position->second->index_name_ = INVALID_NAME;
+    table_position->second.index_name = INVALID_NAME;
     indexes_.erase(position);
 }
 
@@ -55,15 +64,27 @@ Table& Catalog::FetchTable(const std::string &table_name) const {
     if (position == tables_.end()) {
         throw std::logic_error("Fetch table: table does not exist");
     }
-    return *position->second;
+    return *position->second.table;
 }
 
 Index& Catalog::FetchIndex(const std::string &index_name) const {
+    return *GetIndexPtr(index_name);
+}
+
+std::string Catalog::GetTableIndex(const std::string &table_name) const {
+    auto position = tables_.find(table_name);
+    if (position == tables_.end()) {
+        throw std::logic_error("Fetch table: table does not exist");
+    }
+    return position->second.index_name;
+}
+
+std::shared_ptr<Index> Catalog::GetIndexPtr(const std::string &index_name) const {
     auto position = indexes_.find(index_name);
     if (position == indexes_.end()) {
         throw std::logic_error("Fetch table: index does not exist");
     }
-    return *position->second;
+    return position->second;
 }
 
-}
\ No newline at end of file
+}
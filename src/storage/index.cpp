@@ -2,4 +2,31 @@
 
 namespace babydb {
 
-}
\ No newline at end of file
+void Index::AddWriter() {
+    // Pairs with RefuseWriters: either the dropper sees this writer, or this writer sees the drop.
+    active_writers_.fetch_add(1);
+    if (dropped_.load()) {
+        RemoveWriter();
+        throw TaintedException("The index was dropped");
+    }
+}
+
+void Index::RemoveWriter() {
+    if (active_writers_.fetch_sub(1) == 1 && dropped_.load()) {
+        {
+            std::unique_lock lock(writers_latch_);
+        }
+        writers_cv_.notify_all();
+    }
+}
+
+void Index::RefuseWriters() {
+    dropped_.store(true);
+}
+
+void Index::WaitForWriters() {
+    std::unique_lock lock(writers_latch_);
+    writers_cv_.wait(lock, [this] { return active_writers_.load() == 0; });
+}
+
+}
@@ -18,6 +18,15 @@ void StlmapIndex::InsertEntry(const data_t &key, idx_t row_id, ExecutionContext
     index_[key] = row_id;
 };
 
+void StlmapIndex::CatchUp(Table &table, idx_t first_row) {
+    auto read_guard = table.GetReadTableGuard();
+    auto &rows = read_guard.Rows();
+    auto key_attr = table.schema_.GetKeyAttr(key_name_);
+    for (idx_t row_id = first_row; row_id < rows.size(); row_id++) {
+        index_[rows[row_id].tuple_.KeyFromTuple(key_attr)] = row_id;
+    }
+}
+
 idx_t StlmapIndex::LookupKey(const data_t &key, ExecutionContext &exec_ctx) {
     auto ite = index_.find(key);
     if (ite == index_.end()) {
@@ -0,0 +1,776 @@
+#include "gtest/gtest.h"
+
+#include "babydb.hpp"
+#include "concurrency/active_txn_registry.hpp"
+#include "concurrency/epoch_manager.hpp"
+#include "concurrency/version_link.hpp"
+#include "execution/execution_common.hpp"
+#include "execution/increment_operator.hpp"
+#include "execution/insert_operator.hpp"
+#include "execution/value_operator.hpp"
+#include "execution/update_operator.hpp"
+#include "execution/range_index_scan_operator.hpp"
+#include "storage/catalog.hpp"
+#include "storage/index.hpp"
+#include "storage/table.hpp"
+#include "execution/projection_operator.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace babydb {
+
+extern std::atomic<idx_t> current_nodes;
+
+static std::vector<Tuple> RunOperator(Operator &&test_operator) {
+    test_operator.Check();
+    test_operator.Init();
+    std::vector<Tuple> results;
+    DataChunk chunk;
+    auto operator_state = OperatorState::HAVE_MORE_OUTPUT;
+    while (operator_state != EXHAUSETED) {
+        operator_state = test_operator.Next(chunk);
+        for (idx_t position = 0; position < chunk.Size(); position++) {
+            results.push_back(chunk.GetTuple(position));
+        }
+    }
+    return results;
+}
+
+static std::vector<Tuple> Scan(BabyDB &db, std::shared_ptr<Transaction> &txn, const Schema &schema, RangeInfo range) {
+    return RunOperator(RangeIndexScanOperator(db.GetExecutionContext(txn), "t0", schema, schema, "t0_i0", range));
+}
+
+static void Insert(BabyDB &db, std::shared_ptr<Transaction> &txn, const Schema &schema, std::vector<Tuple> &&tuples) {
+    RunOperator(InsertOperator(db.GetExecutionContext(txn),
+        std::make_shared<ValueOperator>(db.GetExecutionContext(txn), schema, std::move(tuples)), "t0"));
+}
+
+static void Update(BabyDB &db, std::shared_ptr<Transaction> &txn, const Schema &schema, data_t key, data_t delta) {
+    auto scan = std::make_shared<RangeIndexScanOperator>(db.GetExecutionContext(txn), "t0", schema, schema, "t0_i0", RangeInfo{key, key});
+    RunOperator(UpdateOperator(db.GetExecutionContext(txn), std::make_shared<ProjectionOperator>(db.GetExecutionContext(txn), scan,
+        std::make_unique<UDProjection>("payload", [delta](Tuple &&a) { return a[0] + delta; }))));
+}
+
+static void Increment(BabyDB &db, std::shared_ptr<Transaction> &txn, const Schema &schema, data_t key, int64_t delta,
+                      const std::optional<EscrowBound> &bound = std::nullopt) {
+    auto scan = std::make_shared<RangeIndexScanOperator>(db.GetExecutionContext(txn), "t0", schema, schema, "t0_i0", RangeInfo{key, key});
+    RunOperator(IncrementOperator(db.GetExecutionContext(txn), scan, "payload", delta, bound));
+}
+
+TEST(ConcurrencyTest, VersionGarbageCollect) {
+    auto nodes_before = current_nodes.load();
+    {
+        VersionSkipList row_list(1, nullptr);
+        for (idx_t ts = 1; ts <= 100; ts++) {
+            row_list.insert_uncommitted_list(ts * 10, ts - 1, TXN_START_ID + ts);
+            row_list.commit(ts);
+        }
+        EXPECT_EQ(current_nodes.load(), nodes_before + 100);
+        // A reader at ts 40 must still see its version, older ones can go.
+        EXPECT_TRUE(row_list.garbage_collect(40));
+        EXPECT_EQ(current_nodes.load(), nodes_before + 61);
+        // The chain ends at the version visible at ts 40. Reads below the watermark are undefined, the version
+        // index may still answer them.
+        idx_t chain_length = 0;
+        Datalist* oldest = nullptr;
+        for (Datalist* node = row_list.newest; node; node = node->next) {
+            oldest = node;
+            chain_length++;
+        }
+        EXPECT_EQ(chain_length, 61);
+        EXPECT_EQ(oldest->ts, 40);
+        EXPECT_EQ(row_list.search_list(40, INVALID_ID), 400);
+        EXPECT_EQ(row_list.search_list(77, INVALID_ID), 770);
+        EXPECT_EQ(row_list.search_list(1000, INVALID_ID), 1000);
+
+        EXPECT_FALSE(row_list.garbage_collect(1000));
+        EXPECT_EQ(current_nodes.load(), nodes_before + 1);
+        EXPECT_EQ(row_list.search_list(1000, INVALID_ID), 1000);
+    }
+    EXPECT_EQ(current_nodes.load(), nodes_before);
+}
+
+TEST(ConcurrencyTest, RegistryWatermark) {
+    ActiveTxnRegistry registry;
+    std::atomic<idx_t> last_commit_ts{0};
+    const idx_t registrant_count = 2, registrations = 5000;
+    // Registrations are unregistered by another thread, racing the next Register on the same shard.
+    std::mutex pending_latch;
+    std::multimap<idx_t, idx_t> pending;
+    std::atomic<idx_t> registrants_done{0};
+    // Watermarks and unregistrations are ordered by their event number.
+    std::atomic<idx_t> events{0};
+    std::vector<std::pair<idx_t, idx_t>> watermarks;
+    std::vector<std::pair<idx_t, idx_t>> unregistered;
+
+    std::vector<std::thread> threads;
+    for (idx_t registrant = 0; registrant < registrant_count; registrant++) {
+        threads.emplace_back([&] {
+            for (idx_t i = 0; i < registrations; i++) {
+                auto [read_ts, shard_id] = registry.Register(last_commit_ts);
+                EXPECT_LE(registry.Watermark(last_commit_ts), read_ts);
+                std::unique_lock lock(pending_latch);
+                pending.emplace(read_ts, shard_id);
+            }
+            registrants_done.fetch_add(1);
+        });
+    }
+    threads.emplace_back([&] {
+        while (registrants_done.load() != registrant_count) {
+            last_commit_ts.fetch_add(1);
+            std::this_thread::yield();
+        }
+    });
+    threads.emplace_back([&] {
+        while (true) {
+            std::unique_lock lock(pending_latch);
+            if (pending.empty()) {
+                lock.unlock();
+                if (registrants_done.load() == registrant_count) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            // The oldest first, so the watermark moves.
+            auto [read_ts, shard_id] = *pending.begin();
+            pending.erase(pending.begin());
+            lock.unlock();
+            unregistered.emplace_back(read_ts, events.fetch_add(1));
+            registry.Unregister(shard_id, read_ts);
+        }
+    });
+    std::thread watermark_thread([&] {
+        while (registrants_done.load() != registrant_count) {
+            auto watermark = registry.Watermark(last_commit_ts);
+            watermarks.emplace_back(events.fetch_add(1), watermark);
+        }
+    });
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    watermark_thread.join();
+
+    // A watermark computed before the Unregister began, even while the Register ran, is not above the read ts.
+    ASSERT_EQ(unregistered.size(), registrant_count * registrations);
+    std::vector<std::pair<idx_t, idx_t>> max_watermarks;
+    for (auto &[event, watermark] : watermarks) {
+        max_watermarks.emplace_back(event, max_watermarks.empty() ? watermark
+                                                                  : std::max(max_watermarks.back().second, watermark));
+    }
+    for (auto &[read_ts, event] : unregistered) {
+        auto iter = std::lower_bound(max_watermarks.begin(), max_watermarks.end(), std::make_pair(event, idx_t(0)));
+        if (iter != max_watermarks.begin()) {
+            EXPECT_LE(std::prev(iter)->second, read_ts);
+        }
+    }
+    EXPECT_EQ(registry.Watermark(last_commit_ts), last_commit_ts.load());
+}
+
+TEST(ConcurrencyTest, UpdateChecksObservedVersion) {
+    BabyDB db;
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+    auto observed_ts = init_txn->GetCommitTs();
+    auto writer = db.CreateTxn();
+    Update(db, writer, schema, 0, 1);
+    ASSERT_TRUE(db.Commit(*writer));
+
+    // A handle read before the last commit is stale, even for a txn that started after it.
+    auto txn = db.CreateTxn();
+    auto exec_ctx = db.GetExecutionContext(txn);
+    auto &table = exec_ctx.catalog_.FetchTable("t0");
+    auto &index = exec_ctx.catalog_.FetchIndex("t0_i0");
+    auto row_list = index.LookupVersions(0);
+    RowHandle stale(row_list->search_list(observed_ts, INVALID_ID), row_list, observed_ts);
+    EXPECT_THROW(UpdateRow(table, index, stale, Tuple{0, 5}, exec_ctx), TaintedException);
+    db.Abort(*txn);
+
+    txn = db.CreateTxn();
+    auto current_ctx = db.GetExecutionContext(txn);
+    RowHandle current(row_list->search_list(txn->read_ts_, INVALID_ID), row_list, txn->read_ts_);
+    UpdateRow(table, index, current, Tuple{0, 5}, current_ctx);
+    EXPECT_TRUE(db.Commit(*txn));
+    txn = db.CreateTxn();
+    EXPECT_EQ(Scan(db, txn, schema, RangeInfo{0, 0}), std::vector<Tuple>{Tuple({0, 5})});
+    EXPECT_TRUE(db.Commit(*txn));
+}
+
+TEST(ConcurrencyTest, SerializableWithoutCycleCommits) {
+    BabyDB db(ConfigGroup{.ISOLATION_LEVEL = IsolationLevel::SERIALIZABLE});
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}, Tuple{10, 10}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    // txn1 -> txn2 is the only dependency, txn1 reads a key overwritten by the committed txn2.
+    auto txn1 = db.CreateTxn();
+    auto txn2 = db.CreateTxn();
+    EXPECT_EQ(Scan(db, txn1, schema, RangeInfo{0, 0}), (std::vector<Tuple>{Tuple{0, 0}}));
+    Update(db, txn2, schema, 0, 1);
+    EXPECT_TRUE(db.Commit(*txn2));
+    Update(db, txn1, schema, 10, 1);
+    EXPECT_TRUE(db.Commit(*txn1));
+
+    auto txn3 = db.CreateTxn();
+    EXPECT_EQ(Scan(db, txn3, schema, RangeInfo{0, 10}), (std::vector<Tuple>{Tuple{0, 1}, Tuple{10, 11}}));
+    EXPECT_TRUE(db.Commit(*txn3));
+}
+
+TEST(ConcurrencyTest, SerializablePhantom) {
+    BabyDB db(ConfigGroup{.ISOLATION_LEVEL = IsolationLevel::SERIALIZABLE});
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}, Tuple{100, 0}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    // Both check that (0, 100) is empty and insert into it, only one may commit.
+    auto txn1 = db.CreateTxn();
+    auto txn2 = db.CreateTxn();
+    RangeInfo inner{0, 100, false, false};
+    EXPECT_EQ(Scan(db, txn1, schema, inner).size(), 0);
+    EXPECT_EQ(Scan(db, txn2, schema, inner).size(), 0);
+    Insert(db, txn1, schema, {Tuple{5, 1}});
+    Insert(db, txn2, schema, {Tuple{6, 1}});
+    EXPECT_EQ(static_cast<idx_t>(db.Commit(*txn1)) + static_cast<idx_t>(db.Commit(*txn2)), 1);
+}
+
+static void RunHotCounters(const ConfigGroup &config, bool row_locking = false) {
+    BabyDB db(config);
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    db.SetRowLocking("t0", row_locking);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}, Tuple{1, 0}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    const idx_t thread_count = 4, tasks_per_thread = 200;
+    std::vector<std::thread> threads;
+    for (idx_t thread_id = 0; thread_id < thread_count; thread_id++) {
+        threads.emplace_back([&db, &schema, thread_id] {
+            for (idx_t i = 0; i < tasks_per_thread; i++) {
+                auto txn = db.CreateTxn();
+                while (true) {
+                    try {
+                        Update(db, txn, schema, (thread_id + i) % 2, 1);
+                        if (db.Commit(*txn)) {
+                            break;
+                        }
+                    } catch (const TaintedException &e) {
+                        db.Abort(*txn);
+                    }
+                    txn = db.RestartTxn(*txn);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto txn = db.CreateTxn();
+    auto result = Scan(db, txn, schema, RangeInfo{0, 1});
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0][1] + result[1][1], thread_count * tasks_per_thread);
+    EXPECT_TRUE(db.Commit(*txn));
+}
+
+TEST(ConcurrencyTest, ContentionPolicies) {
+    RunHotCounters(ConfigGroup{.CONTENTION_POLICY = ContentionPolicy::WAIT_DIE});
+    RunHotCounters(ConfigGroup{.CONTENTION_POLICY = ContentionPolicy::BACKOFF});
+}
+
+TEST(ConcurrencyTest, WaitDieRetryKeepsPriority) {
+    BabyDB db(ConfigGroup{.CONTENTION_POLICY = ContentionPolicy::WAIT_DIE, .MAX_CONTENTION_WAIT_US = 1000000});
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    // The retry is older than a txn started after its first attempt, so it waits for it instead of dying.
+    auto first_attempt = db.CreateTxn();
+    auto holder = db.CreateTxn();
+    db.Abort(*first_attempt);
+    auto retry = db.RestartTxn(*first_attempt);
+    EXPECT_GT(retry->txn_id_, holder->txn_id_);
+    EXPECT_LT(retry->priority_, holder->priority_);
+    Update(db, holder, schema, 0, 1);
+    std::atomic<bool> done{false};
+    std::thread retry_thread([&] {
+        try {
+            Update(db, retry, schema, 0, 1);
+        } catch (const TaintedException &e) {
+            // It read the row before the holder committed.
+            db.Abort(*retry);
+        }
+        done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(done.load());
+    EXPECT_TRUE(db.Commit(*holder));
+    retry_thread.join();
+    EXPECT_TRUE(done.load());
+}
+
+TEST(ConcurrencyTest, CommutativeIncrements) {
+    BabyDB db;
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 1}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    const idx_t thread_count = 4, tasks_per_thread = 200;
+    std::vector<std::thread> threads;
+    for (idx_t thread_id = 0; thread_id < thread_count; thread_id++) {
+        threads.emplace_back([&db, &schema] {
+            for (idx_t i = 0; i < tasks_per_thread; i++) {
+                auto txn = db.CreateTxn();
+                Increment(db, txn, schema, 0, 1);
+                EXPECT_TRUE(db.Commit(*txn));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // Only one of two concurrent decrements fits above the bound.
+    auto txn1 = db.CreateTxn();
+    auto txn2 = db.CreateTxn();
+    auto total = thread_count * tasks_per_thread + 1;
+    Increment(db, txn1, schema, 0, -static_cast<int64_t>(total), EscrowBound{0, DATA_MAX});
+    EXPECT_THROW(Increment(db, txn2, schema, 0, -1, EscrowBound{0, DATA_MAX}), TaintedException);
+    db.Abort(*txn2);
+    // An update conflicts with the pending decrement.
+    auto txn3 = db.CreateTxn();
+    EXPECT_THROW(Update(db, txn3, schema, 0, 1), TaintedException);
+    db.Abort(*txn3);
+    EXPECT_TRUE(db.Commit(*txn1));
+
+    auto txn = db.CreateTxn();
+    auto result = Scan(db, txn, schema, RangeInfo{0, 0});
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0][1], 0);
+    EXPECT_TRUE(db.Commit(*txn));
+}
+
+TEST(ConcurrencyTest, PrivateWriteSet) {
+    BabyDB db;
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto table_rows = [&db] {
+        auto txn = db.CreateTxn();
+        auto &table = db.GetExecutionContext(txn).catalog_.FetchTable("t0");
+        auto rows = table.GetReadTableGuard().Rows().size();
+        db.Abort(*txn);
+        return rows;
+    };
+
+    auto txn1 = db.CreateTxn();
+    Insert(db, txn1, schema, {Tuple{0, 1}, Tuple{1, 1}});
+    Update(db, txn1, schema, 0, 1);
+    auto own = Scan(db, txn1, schema, RangeInfo{0, 1});
+    ASSERT_EQ(own.size(), 2);
+    EXPECT_EQ(own[0][1], 2);
+    EXPECT_EQ(table_rows(), 0);
+    db.Abort(*txn1);
+    EXPECT_EQ(table_rows(), 0);
+    // The aborted keys left the index too.
+    auto reader = db.CreateTxn();
+    auto &index = db.GetExecutionContext(reader).catalog_.FetchIndex("t0_i0");
+    EXPECT_EQ(index.LookupVersions(0), nullptr);
+    EXPECT_EQ(index.LookupVersions(1), nullptr);
+    EXPECT_TRUE(db.Commit(*reader));
+
+    auto txn2 = db.CreateTxn();
+    Insert(db, txn2, schema, {Tuple{0, 5}});
+    Update(db, txn2, schema, 0, 1);
+    EXPECT_TRUE(db.Commit(*txn2));
+    // The rewrite of key 0 replaced the tuple in the write set.
+    EXPECT_EQ(table_rows(), 1);
+    auto txn = db.CreateTxn();
+    auto result = Scan(db, txn, schema, RangeInfo{0, 1});
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0][1], 6);
+    EXPECT_TRUE(db.Commit(*txn));
+}
+
+TEST(ConcurrencyTest, AsOfSnapshots) {
+    BabyDB db(ConfigGroup{.GC_INTERVAL_MS = 1, .HISTORY_RETENTION = 2});
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto txn = db.CreateTxn();
+    Insert(db, txn, schema, {Tuple{0, 0}});
+    ASSERT_TRUE(db.Commit(*txn));
+    auto first_ts = txn->GetCommitTs();
+    auto snapshot_ts = db.CreateSnapshot("day1");
+    EXPECT_EQ(snapshot_ts, first_ts);
+    EXPECT_THROW(db.CreateSnapshot("day1"), std::logic_error);
+    for (data_t i = 1; i <= 10; i++) {
+        txn = db.CreateTxn();
+        Update(db, txn, schema, 0, 1);
+        ASSERT_TRUE(db.Commit(*txn));
+    }
+    auto last_ts = txn->GetCommitTs();
+    EXPECT_THROW(db.CreateTxnAsOf(last_ts + 1), std::logic_error);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto payload_as_of = [&](std::shared_ptr<Transaction> as_of_txn) {
+        auto result = Scan(db, as_of_txn, schema, RangeInfo{0, 0});
+        EXPECT_THROW(Update(db, as_of_txn, schema, 0, 1), std::logic_error);
+        EXPECT_TRUE(db.Commit(*as_of_txn));
+        return result.size() == 1 ? result[0][1] : INVALID_ID;
+    };
+    EXPECT_EQ(payload_as_of(db.CreateTxnAsOf("day1")), 0);
+    EXPECT_EQ(payload_as_of(db.CreateTxnAsOf(last_ts - 1)), 9);
+    EXPECT_EQ(payload_as_of(db.CreateTxnAsOf(last_ts)), 10);
+
+    // Without the snapshot only the retained history is kept.
+    db.DropSnapshot("day1");
+    EXPECT_THROW(db.CreateTxnAsOf("day1"), std::logic_error);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_THROW(db.CreateTxnAsOf(first_ts + 3), std::logic_error);
+    EXPECT_EQ(payload_as_of(db.CreateTxnAsOf(last_ts - 2)), 8);
+
+    // A rebuilt index has no history, older reads through it are refused.
+    db.DropIndex("t0_i0");
+    db.CreateIndex("t0_i1", "t0", "key", IndexType::ART);
+    auto scan_rebuilt = [&](std::shared_ptr<Transaction> as_of_txn) {
+        return RunOperator(RangeIndexScanOperator(db.GetExecutionContext(as_of_txn), "t0", schema, schema, "t0_i1",
+                                                  RangeInfo{0, 0}));
+    };
+    EXPECT_THROW(scan_rebuilt(db.CreateTxnAsOf(last_ts - 1)), std::logic_error);
+    EXPECT_EQ(scan_rebuilt(db.CreateTxnAsOf(last_ts)), std::vector<Tuple>{Tuple({0, 10})});
+}
+
+TEST(ConcurrencyTest, ReadOnlyCommitTakesNoTs) {
+    BabyDB db;
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    // It is serialized at its read ts and leaves the frontier where it was.
+    auto reader = db.CreateTxn();
+    EXPECT_EQ(Scan(db, reader, schema, RangeInfo{0, 0}), std::vector<Tuple>{Tuple({0, 0})});
+    EXPECT_TRUE(db.Commit(*reader));
+    EXPECT_EQ(reader->GetCommitTs(), reader->read_ts_);
+    auto next = db.CreateTxn();
+    EXPECT_EQ(next->read_ts_, reader->read_ts_);
+    Update(db, next, schema, 0, 1);
+    EXPECT_TRUE(db.Commit(*next));
+    EXPECT_EQ(next->GetCommitTs(), reader->read_ts_ + 1);
+}
+
+TEST(ConcurrencyTest, PublishInCommitOrder) {
+    BabyDB db;
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    const idx_t writer_count = 3, commits_per_writer = 200, reader_count = 2, scans_per_reader = 200;
+    auto init_txn = db.CreateTxn();
+    for (idx_t key = 0; key < writer_count; key++) {
+        Insert(db, init_txn, schema, {Tuple{static_cast<data_t>(key), 0}});
+    }
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    // Every writer increments its own key, so the commits never conflict and only their ts order them.
+    std::vector<std::vector<idx_t>> commit_ts(writer_count);
+    std::vector<std::vector<std::pair<idx_t, std::vector<Tuple>>>> snapshots(reader_count);
+    std::vector<std::thread> threads;
+    for (idx_t writer_id = 0; writer_id < writer_count; writer_id++) {
+        threads.emplace_back([&db, &schema, &commit_ts, writer_id] {
+            for (idx_t i = 0; i < commits_per_writer; i++) {
+                auto txn = db.CreateTxn();
+                Update(db, txn, schema, writer_id, 1);
+                ASSERT_TRUE(db.Commit(*txn));
+                commit_ts[writer_id].push_back(txn->GetCommitTs());
+            }
+        });
+    }
+    for (idx_t reader_id = 0; reader_id < reader_count; reader_id++) {
+        threads.emplace_back([&db, &schema, &snapshots, reader_id] {
+            for (idx_t i = 0; i < scans_per_reader; i++) {
+                auto txn = db.CreateTxn();
+                snapshots[reader_id].emplace_back(txn->read_ts_, Scan(db, txn, schema, RangeInfo{0, static_cast<data_t>(writer_count - 1)}));
+                ASSERT_TRUE(db.Commit(*txn));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // A reader sees exactly the commits at or below its read ts: none is published before a smaller one installed.
+    for (auto &reader_snapshots : snapshots) {
+        for (auto &[read_ts, tuples] : reader_snapshots) {
+            ASSERT_EQ(tuples.size(), writer_count);
+            for (idx_t writer_id = 0; writer_id < writer_count; writer_id++) {
+                auto &writer_ts = commit_ts[writer_id];
+                auto installed = std::upper_bound(writer_ts.begin(), writer_ts.end(), read_ts) - writer_ts.begin();
+                EXPECT_EQ(tuples[writer_id][1], installed);
+            }
+        }
+    }
+}
+
+TEST(ConcurrencyTest, OccValidation) {
+    BabyDB db(ConfigGroup{.CONCURRENCY_CONTROL = ConcurrencyControlType::OCC});
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}, Tuple{10, 10}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    // Write skew: both read both keys and update different ones.
+    auto txn1 = db.CreateTxn();
+    auto txn2 = db.CreateTxn();
+    EXPECT_EQ(Scan(db, txn1, schema, RangeInfo{0, 10}).size(), 2);
+    EXPECT_EQ(Scan(db, txn2, schema, RangeInfo{0, 10}).size(), 2);
+    Update(db, txn1, schema, 0, 1);
+    Update(db, txn2, schema, 10, 1);
+    // txn1 finds key 10 locked by txn2 and fails, txn2 validates after txn1 released key 0.
+    EXPECT_FALSE(db.Commit(*txn1));
+    EXPECT_TRUE(db.Commit(*txn2));
+
+    // A key inserted into a scanned range fails the scanning writer, but not a reader of the old snapshot.
+    auto reader = db.CreateTxn();
+    auto writer = db.CreateTxn();
+    EXPECT_EQ(Scan(db, reader, schema, RangeInfo{1, 9}).size(), 0);
+    EXPECT_EQ(Scan(db, writer, schema, RangeInfo{1, 9}).size(), 0);
+    auto inserter = db.CreateTxn();
+    Insert(db, inserter, schema, {Tuple{5, 5}});
+    EXPECT_TRUE(db.Commit(*inserter));
+    Update(db, writer, schema, 10, 1);
+    EXPECT_FALSE(db.Commit(*writer));
+    EXPECT_TRUE(db.Commit(*reader));
+    // Only committed inserts count.
+    writer = db.CreateTxn();
+    EXPECT_EQ(Scan(db, writer, schema, RangeInfo{6, 9}).size(), 0);
+    inserter = db.CreateTxn();
+    Insert(db, inserter, schema, {Tuple{6, 6}});
+    db.Abort(*inserter);
+    Update(db, writer, schema, 10, 1);
+    EXPECT_TRUE(db.Commit(*writer));
+
+    // The ts of the failed commits were published, later commits don't wait for them.
+    auto txn = db.CreateTxn();
+    EXPECT_EQ(Scan(db, txn, schema, RangeInfo{0, 10}), (std::vector<Tuple>{Tuple{0, 0}, Tuple{5, 5}, Tuple{10, 12}}));
+    Update(db, txn, schema, 5, 1);
+    EXPECT_TRUE(db.Commit(*txn));
+
+    RunHotCounters(ConfigGroup{.CONCURRENCY_CONTROL = ConcurrencyControlType::OCC});
+}
+
+TEST(ConcurrencyTest, FailedValidationPublishesTs) {
+    BabyDB db(ConfigGroup{.CONCURRENCY_CONTROL = ConcurrencyControlType::OCC});
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}, Tuple{10, 10}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    // The read of key 0 fails the validation after the ts is taken.
+    auto failing = db.CreateTxn();
+    EXPECT_EQ(Scan(db, failing, schema, RangeInfo{0, 0}), std::vector<Tuple>{Tuple({0, 0})});
+    Update(db, failing, schema, 10, 1);
+    auto writer = db.CreateTxn();
+    Update(db, writer, schema, 0, 1);
+    EXPECT_TRUE(db.Commit(*writer));
+    EXPECT_FALSE(db.Commit(*failing));
+    EXPECT_EQ(failing->GetCommitTs(), writer->GetCommitTs() + 1);
+
+    // The aborted ts is published, the next commit doesn't wait for it.
+    auto next = db.CreateTxn();
+    EXPECT_EQ(next->read_ts_, failing->GetCommitTs());
+    EXPECT_EQ(Scan(db, next, schema, RangeInfo{0, 10}), (std::vector<Tuple>{Tuple{0, 1}, Tuple{10, 10}}));
+    Update(db, next, schema, 10, 1);
+    EXPECT_TRUE(db.Commit(*next));
+    auto reader = db.CreateTxn();
+    EXPECT_EQ(reader->read_ts_, next->GetCommitTs());
+    EXPECT_EQ(Scan(db, reader, schema, RangeInfo{10, 10}), std::vector<Tuple>{Tuple({10, 11})});
+    EXPECT_TRUE(db.Commit(*reader));
+}
+
+TEST(ConcurrencyTest, RowLocks) {
+    BabyDB db;
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}, Tuple{1, 0}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    // A writer waits for the shared lock of an older reader.
+    auto reader = db.CreateTxn(true);
+    EXPECT_EQ(Scan(db, reader, schema, RangeInfo{0, 0}), std::vector<Tuple>{Tuple({0, 0})});
+    auto writer = db.CreateTxn(true);
+    std::atomic<bool> updated{false};
+    std::thread update_thread([&] {
+        Update(db, writer, schema, 0, 1);
+        updated = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(updated.load());
+    EXPECT_TRUE(db.Commit(*reader));
+    update_thread.join();
+    EXPECT_TRUE(db.Commit(*writer));
+
+    // The second writer updates the version the first one committed while it waited, not its snapshot.
+    auto first = db.CreateTxn(true);
+    auto second = db.CreateTxn(true);
+    Update(db, first, schema, 0, 1);
+    update_thread = std::thread([&] { Update(db, second, schema, 0, 1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(db.Commit(*first));
+    update_thread.join();
+    EXPECT_TRUE(db.Commit(*second));
+
+    // Wound-wait: the older txn wounds the younger one holding the row it waits for.
+    auto older = db.CreateTxn(true);
+    auto younger = db.CreateTxn(true);
+    Update(db, older, schema, 1, 1);
+    Update(db, younger, schema, 0, 1);
+    std::atomic<bool> wounded{false};
+    update_thread = std::thread([&] {
+        try {
+            Update(db, younger, schema, 1, 1);
+        } catch (const TaintedException &e) {
+            wounded = true;
+            db.Abort(*younger);
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    Update(db, older, schema, 0, 1);
+    update_thread.join();
+    EXPECT_TRUE(wounded.load());
+    EXPECT_TRUE(db.Commit(*older));
+
+    // The retry of the wounded txn is older than a txn started after its first attempt, and wounds it in turn.
+    auto retry = db.RestartTxn(*younger);
+    auto newer = db.CreateTxn(true);
+    Update(db, newer, schema, 1, 1);
+    update_thread = std::thread([&] { Update(db, retry, schema, 1, 1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(newer->Wounded());
+    EXPECT_FALSE(db.Commit(*newer));
+    update_thread.join();
+    EXPECT_TRUE(db.Commit(*retry));
+
+    auto txn = db.CreateTxn();
+    EXPECT_EQ(Scan(db, txn, schema, RangeInfo{0, 1}), (std::vector<Tuple>{Tuple{0, 4}, Tuple{1, 2}}));
+    EXPECT_TRUE(db.Commit(*txn));
+
+    RunHotCounters(ConfigGroup{}, true);
+}
+
+TEST(ConcurrencyTest, AdmissionControl) {
+    BabyDB db(ConfigGroup{.MAX_WRITE_TXNS = 1});
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}, Tuple{1, 0}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+    EXPECT_EQ(db.GetAdmissionLimit(), 1);
+
+    // Readers are not capped, the second writer waits at its first write.
+    auto writer = db.CreateTxn();
+    Update(db, writer, schema, 0, 1);
+    auto reader = db.CreateTxn();
+    EXPECT_EQ(Scan(db, reader, schema, RangeInfo{0, 1}).size(), 2);
+    EXPECT_TRUE(db.Commit(*reader));
+    auto queued = db.CreateTxn();
+    std::atomic<bool> updated{false};
+    std::thread update_thread([&] {
+        Update(db, queued, schema, 1, 1);
+        updated = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(updated.load());
+    EXPECT_TRUE(db.Commit(*writer));
+    update_thread.join();
+    EXPECT_TRUE(db.Commit(*queued));
+    EXPECT_EQ(db.GetAdmissionLimit(), 1);
+
+    RunHotCounters(ConfigGroup{.MAX_WRITE_TXNS = 4});
+}
+
+TEST(ConcurrencyTest, OnlineDdl) {
+    BabyDB db;
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    auto init_txn = db.CreateTxn();
+    Insert(db, init_txn, schema, {Tuple{0, 0}, Tuple{1, 0}});
+    ASSERT_TRUE(db.Commit(*init_txn));
+
+    // DDL doesn't wait for running transactions, they keep their catalog version.
+    auto old_txn = db.CreateTxn();
+    auto old_reader = db.CreateTxn();
+    auto late_writer = db.CreateTxn();
+    Update(db, old_txn, schema, 0, 1);
+    db.CreateTable("t1", schema);
+    db.CreateIndex("t1_i0", "t1", "key", IndexType::ART);
+    EXPECT_THROW(db.GetExecutionContext(old_txn).catalog_.FetchTable("t1"), std::logic_error);
+    db.DropIndex("t0_i0");
+
+    // The new index waits for the writers through the dropped one, and indexes what they committed.
+    std::atomic<bool> created{false};
+    std::thread ddl_thread([&] {
+        db.CreateIndex("t0_i1", "t0", "key", IndexType::ART);
+        created = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(created.load());
+    // The build waits without blocking other DDL. A txn that didn't write through the dropped index can't anymore.
+    db.CreateTable("t2", schema);
+    EXPECT_THROW(Update(db, late_writer, schema, 1, 1), TaintedException);
+    db.Abort(*late_writer);
+    Update(db, old_txn, schema, 1, 1);
+    EXPECT_TRUE(db.Commit(*old_txn));
+    // Readers of the old catalog version are not waited for.
+    ddl_thread.join();
+    EXPECT_EQ(Scan(db, old_reader, schema, RangeInfo{0, 1}), (std::vector<Tuple>{Tuple{0, 0}, Tuple{1, 0}}));
+    EXPECT_TRUE(db.Commit(*old_reader));
+
+    auto txn = db.CreateTxn();
+    EXPECT_EQ(RunOperator(RangeIndexScanOperator(db.GetExecutionContext(txn), "t0", schema, schema, "t0_i1",
+                                                 RangeInfo{0, 1})),
+              (std::vector<Tuple>{Tuple{0, 1}, Tuple{1, 1}}));
+    EXPECT_TRUE(db.Commit(*txn));
+
+    // A transaction may hold the last catalog version with an index after the database is gone.
+    std::shared_ptr<Transaction> survivor;
+    {
+        BabyDB other_db;
+        other_db.CreateTable("t0", schema);
+        other_db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+        survivor = other_db.CreateTxn();
+        Update(other_db, survivor, schema, 0, 1);
+    }
+    survivor.reset();
+}
+
+}
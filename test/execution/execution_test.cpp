@@ -0,0 +1,533 @@
+#include "gtest/gtest.h"
+
+#include "babydb.hpp"
+#include "execution/aggregate_operator.hpp"
+#include "execution/expression/predicate_kernels.hpp"
+#include "execution/filter_operator.hpp"
+#include "execution/hash_join_operator.hpp"
+#include "execution/insert_operator.hpp"
+#include "execution/merge_join_operator.hpp"
+#include "execution/pipeline.hpp"
+#include "execution/projection_operator.hpp"
+#include "execution/range_index_scan_operator.hpp"
+#include "execution/sort_operator.hpp"
+#include "execution/topk_operator.hpp"
+#include "execution/value_operator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+
+namespace babydb {
+
+static std::vector<Tuple> RunOperator(Operator &test_operator, bool sort_output = true) {
+    test_operator.Check();
+    test_operator.Init();
+    std::vector<Tuple> results;
+    DataChunk chunk;
+    auto operator_state = OperatorState::HAVE_MORE_OUTPUT;
+    while (operator_state != EXHAUSETED) {
+        operator_state = test_operator.Next(chunk);
+        for (idx_t position = 0; position < chunk.Size(); position++) {
+            results.push_back(chunk.GetTuple(position));
+        }
+    }
+    if (sort_output) {
+        std::sort(results.begin(), results.end());
+    }
+    return results;
+}
+
+static std::unique_ptr<Expression> Col(const std::string &column_name) {
+    return std::make_unique<ColumnRefExpression>(column_name);
+}
+
+static std::unique_ptr<Expression> Const(data_t value) {
+    return std::make_unique<ConstantExpression>(value);
+}
+
+static std::unique_ptr<Expression> Binary(ExpressionType type, std::unique_ptr<Expression> &&left,
+                                          std::unique_ptr<Expression> &&right) {
+    return std::make_unique<BinaryExpression>(type, std::move(left), std::move(right));
+}
+
+TEST(ExecutionTest, ExpressionFilterAndProjection) {
+    BabyDB db(ConfigGroup{.CHUNK_SUGGEST_SIZE = 3});
+    auto txn = db.CreateTxn();
+    auto exec_ctx = db.GetExecutionContext(txn);
+    Schema schema{"key", "payload"};
+    std::vector<Tuple> tuples;
+    for (data_t key = 0; key < 10; key++) {
+        tuples.push_back(Tuple{key, key * 10});
+    }
+    auto values = std::make_shared<ValueOperator>(exec_ctx, schema, std::move(tuples));
+
+    // key % 2 = 0 AND NOT payload > 60, the chunks hold 3 rows so the selections differ.
+    std::vector<std::unique_ptr<Filter>> filters;
+    filters.push_back(std::make_unique<ExpressionFilter>(Binary(ExpressionType::AND,
+        Binary(ExpressionType::EQUAL, Binary(ExpressionType::MODULO, Col("key"), Const(2)), Const(0)),
+        std::make_unique<NotExpression>(Binary(ExpressionType::GREATER, Col("payload"), Const(60))))));
+    auto filter = std::make_shared<FilterOperator>(exec_ctx, values, std::move(filters));
+
+    // CASE WHEN key != 0 THEN payload / key ELSE 100 END, the division only sees the rows taking its branch.
+    std::vector<std::unique_ptr<Projection>> projections;
+    projections.push_back(std::make_unique<UnitProjection>("key"));
+    projections.push_back(std::make_unique<ExpressionProjection>("quotient", std::make_unique<CaseExpression>(
+        Binary(ExpressionType::NOT_EQUAL, Col("key"), Const(0)),
+        Binary(ExpressionType::DIVIDE, Col("payload"), Col("key")),
+        Const(100))));
+    projections.push_back(std::make_unique<ExpressionProjection>("sum",
+        Binary(ExpressionType::ADD, Col("key"), Col("payload"))));
+    auto projection = ProjectionOperator(exec_ctx, filter, std::move(projections), false);
+    EXPECT_EQ(RunOperator(projection, false),
+              (std::vector<Tuple>{{0, 100, 0}, {2, 10, 22}, {4, 10, 44}, {6, 10, 66}}));
+
+    // One row at a time, the right side of OR only runs when the left one is false.
+    auto expression = Binary(ExpressionType::OR, Binary(ExpressionType::LESS, Col("b"), Col("a")),
+                             Binary(ExpressionType::DIVIDE, Col("a"), Col("b")));
+    EXPECT_EQ(BindColumns(*expression), (Schema{"b", "a"}));
+    EXPECT_EQ(expression->Evaluate(Tuple{1, 5}), 1);
+    EXPECT_EQ(expression->Evaluate(Tuple{5, 10}), 1);
+    EXPECT_EQ(expression->Evaluate(Tuple{5, 1}), 0);
+    EXPECT_THROW(expression->Evaluate(Tuple{0, 0}), std::logic_error);
+}
+
+TEST(ExecutionTest, RangeKernels) {
+    BabyDB db(ConfigGroup{.CHUNK_SUGGEST_SIZE = 37});
+    auto txn = db.CreateTxn();
+    auto exec_ctx = db.GetExecutionContext(txn);
+    Schema schema{"key", "group", "payload"};
+    std::vector<Tuple> tuples;
+    std::vector<Tuple> expected;
+    for (data_t key = 0; key < 1000; key++) {
+        tuples.push_back(Tuple{key, key % 7, key * 3});
+        if (key > 100 && key <= 900 && key % 7 == 3 && key % 2 == 0 && key * 3 < 2000) {
+            expected.push_back(tuples.back());
+        }
+    }
+
+    auto original_level = GetSimdLevel();
+    for (auto level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        SetSimdLevel(level);
+        auto tuples_copy = tuples;
+        auto values = std::make_shared<ValueOperator>(exec_ctx, schema, std::move(tuples_copy));
+        // The ranges of the first filter operator run fused on whole chunks, the second one narrows a selection.
+        std::vector<std::unique_ptr<Filter>> filters;
+        filters.push_back(std::make_unique<RangeFilter>("key", RangeInfo{100, 900, false, true}));
+        filters.push_back(std::make_unique<UDFilter>(Schema{"key"}, [](Tuple &&keys) { return keys[0] % 2 == 0; }));
+        filters.push_back(std::make_unique<EqualFilter>("group", 3));
+        auto first_filter = std::make_shared<FilterOperator>(exec_ctx, values, std::move(filters));
+        auto second_filter = FilterOperator(exec_ctx, first_filter,
+                                            std::make_unique<RangeFilter>("payload", RangeInfo{0, 2000, true, false}));
+        EXPECT_EQ(RunOperator(second_filter, false), expected);
+    }
+    SetSimdLevel(original_level);
+
+    // Open ends at the limits of data_t select nothing.
+    auto values = std::make_shared<ValueOperator>(exec_ctx, schema, std::vector<Tuple>{{0, 0, 0}});
+    auto empty_filter = FilterOperator(exec_ctx, values, std::make_unique<RangeFilter>("key", RangeInfo{0, 0, true, false}));
+    EXPECT_EQ(RunOperator(empty_filter), std::vector<Tuple>());
+}
+
+TEST(ExecutionTest, DataChunkSelection) {
+    BabyDB db;
+    auto txn = db.CreateTxn();
+    auto exec_ctx = db.GetExecutionContext(txn);
+    Schema schema{"key", "payload"};
+    auto values = std::make_shared<ValueOperator>(exec_ctx, schema, std::vector<Tuple>());
+    DataChunk chunk;
+    chunk.Reset(2);
+    for (data_t key = 0; key < 8; key++) {
+        chunk.Append({key, key * 10}, RowHandle(key + 100));
+    }
+
+    // A filter only rewrites the selection, the columns stay where they are.
+    std::vector<std::unique_ptr<Filter>> filters;
+    filters.push_back(std::make_unique<RangeFilter>("key", RangeInfo{2, 6}));
+    filters.push_back(std::make_unique<UDFilter>(Schema{"key"}, [](Tuple &&keys) { return keys[0] % 2 == 1; }));
+    FilterOperator filter(exec_ctx, values, std::move(filters));
+    filter.Check();
+    filter.Init();
+    auto keys = chunk.Column(0).data();
+    filter.ExecuteChunk(chunk);
+    EXPECT_TRUE(chunk.HasSelection());
+    EXPECT_EQ(chunk.SelectedRows(), (std::vector<idx_t>{3, 5}));
+    EXPECT_EQ(chunk.Column(0).data(), keys);
+    EXPECT_EQ(chunk.Column(0).size(), 8);
+
+    // Positions address the selected rows.
+    EXPECT_EQ(chunk.Size(), 2);
+    EXPECT_EQ(chunk.GetValue(1, 0), 30);
+    EXPECT_EQ(chunk.GetTuple(1), (Tuple{5, 50}));
+    EXPECT_EQ(chunk.GetTuple(0, {1}), Tuple({30}));
+    EXPECT_EQ(chunk.GetHandle(0).row_id, 103);
+    EXPECT_EQ(chunk.GetHandle(1).row_id, 105);
+
+    // Appending a chunk copies its selected rows only.
+    DataChunk target;
+    target.Reset(2);
+    target.Append({9, 90}, RowHandle(99));
+    target.Append(chunk);
+    EXPECT_FALSE(target.HasSelection());
+    EXPECT_EQ(target.Column(0), (std::vector<data_t>{9, 3, 5}));
+    EXPECT_EQ(target.Column(1), (std::vector<data_t>{90, 30, 50}));
+    EXPECT_EQ(target.GetHandle(1).row_id, 103);
+    EXPECT_EQ(target.GetHandle(2).row_id, 105);
+
+    // A second filter narrows the selection.
+    FilterOperator narrow(exec_ctx, values, std::make_unique<RangeFilter>("key", RangeInfo{4, 7}));
+    narrow.Check();
+    narrow.Init();
+    narrow.ExecuteChunk(chunk);
+    EXPECT_EQ(chunk.SelectedRows(), std::vector<idx_t>{5});
+    EXPECT_EQ(chunk.GetTuple(0), (Tuple{5, 50}));
+    EXPECT_EQ(chunk.GetHandle(0).row_id, 105);
+}
+
+TEST(ExecutionTest, ParallelPipelines) {
+    BabyDB db(ConfigGroup{.WORKER_THREADS = 4, .MORSEL_SIZE = 100});
+    Schema schema{"key", "group", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+    const data_t n = 5000;
+    std::vector<Tuple> tuples;
+    for (data_t key = 0; key < n; key++) {
+        tuples.push_back(Tuple{key, key % 10, key});
+    }
+    auto txn = db.CreateTxn();
+    auto insert_operator = InsertOperator(db.GetExecutionContext(txn),
+        std::make_shared<ValueOperator>(db.GetExecutionContext(txn), schema, std::move(tuples)), "t0");
+    RunOperator(insert_operator);
+    EXPECT_EQ(db.Commit(*txn), true);
+
+    txn = db.CreateTxn();
+    auto exec_ctx = db.GetExecutionContext(txn);
+    auto scan = [&exec_ctx, &schema](const Schema &output_schema) {
+        return std::make_shared<RangeIndexScanOperator>(exec_ctx, "t0", schema, output_schema, "t0_i0",
+                                                        RangeInfo{DATA_MIN, DATA_MAX});
+    };
+
+    // scan -> filter -> projection, collected in the order of the morsels.
+    auto filter = std::make_shared<FilterOperator>(exec_ctx, scan(schema),
+        std::make_unique<ExpressionFilter>(Binary(ExpressionType::EQUAL, Col("group"), Const(3))));
+    auto projection = ProjectionOperator(exec_ctx, filter, std::make_unique<ExpressionProjection>("double",
+        Binary(ExpressionType::MULTIPLY, Col("payload"), Const(2))), false);
+    projection.Check();
+    projection.Init();
+    std::vector<Tuple> results;
+    for (auto &chunk : ExecuteParallel(projection, exec_ctx.thread_pool_)) {
+        for (idx_t position = 0; position < chunk.Size(); position++) {
+            results.push_back(chunk.GetTuple(position));
+        }
+    }
+    std::vector<Tuple> expected;
+    for (data_t key = 3; key < n; key += 10) {
+        expected.push_back(Tuple{key * 2});
+    }
+    EXPECT_EQ(results, expected);
+
+    // scan -> join probe -> aggregate, the join's build side is a pipeline of its own.
+    auto join = std::make_shared<HashJoinOperator>(exec_ctx, scan(Schema{"a.key", "a.group", "a.payload"}),
+                                                   scan(Schema{"b.key", "b.group", "b.payload"}), "a.key", "b.payload");
+    auto aggregate = AggregateOperator(exec_ctx, join, "a.group", "b.key");
+    expected.clear();
+    for (data_t group = 0; group < 10; group++) {
+        expected.push_back(Tuple{group, (n / 10) * (n / 10 - 1) / 2 * 10 + group * (n / 10)});
+    }
+    EXPECT_EQ(RunOperator(aggregate), expected);
+    EXPECT_EQ(db.Commit(*txn), true);
+}
+
+TEST(ExecutionTest, RadixHashJoin) {
+    BabyDB db(ConfigGroup{.WORKER_THREADS = 4, .MORSEL_SIZE = 1000});
+    auto txn = db.CreateTxn();
+    auto exec_ctx = db.GetExecutionContext(txn);
+    // Large enough for several radix partitions, every probe key below half matches two build rows.
+    const data_t n = 70000;
+    std::vector<Tuple> probe_tuples;
+    std::vector<Tuple> build_tuples;
+    for (data_t i = 0; i < n; i++) {
+        probe_tuples.push_back(Tuple{i, 1});
+        build_tuples.push_back(Tuple{i % (n / 2), i});
+    }
+    auto join = std::make_shared<HashJoinOperator>(exec_ctx,
+        std::make_shared<ValueOperator>(exec_ctx, Schema{"a.key", "a.one"}, std::move(probe_tuples)),
+        std::make_shared<ValueOperator>(exec_ctx, Schema{"b.key", "b.value"}, std::move(build_tuples)),
+        "a.key", "b.key");
+    join->Check();
+    join->Init();
+    idx_t match_count = 0;
+    for (auto &chunk : ExecuteParallel(*join, exec_ctx.thread_pool_)) {
+        for (idx_t position = 0; position < chunk.Size(); position++) {
+            auto tuple = chunk.GetTuple(position);
+            EXPECT_EQ(tuple[0], tuple[2]);
+            EXPECT_EQ(tuple[3] % (n / 2), tuple[0]);
+        }
+        match_count += chunk.Size();
+    }
+    EXPECT_EQ(match_count, n);
+
+    auto aggregate = AggregateOperator(exec_ctx, join, "a.one", "b.value");
+    EXPECT_EQ(RunOperator(aggregate), (std::vector<Tuple>{{1, n * (n - 1) / 2}}));
+
+    // A key with many build rows has one slot, its matches come in build order.
+    std::vector<Tuple> skewed_tuples;
+    for (data_t i = 0; i < n; i++) {
+        skewed_tuples.push_back(Tuple{i % 10 == 0 ? i : 7, i});
+    }
+    auto skewed_join = HashJoinOperator(exec_ctx,
+        std::make_shared<ValueOperator>(exec_ctx, Schema{"a.key", "a.one"}, std::vector<Tuple>{Tuple{7, 1}}),
+        std::make_shared<ValueOperator>(exec_ctx, Schema{"b.key", "b.value"}, std::move(skewed_tuples)),
+        "a.key", "b.key");
+    auto skewed_result = RunOperator(skewed_join);
+    ASSERT_EQ(skewed_result.size(), n - n / 10);
+    for (idx_t i = 1; i < skewed_result.size(); i++) {
+        EXPECT_LT(skewed_result[i - 1][3], skewed_result[i][3]);
+    }
+}
+
+TEST(ExecutionTest, BloomFilterPushdown) {
+    BabyDB db(ConfigGroup{.WORKER_THREADS = 2});
+    auto txn = db.CreateTxn();
+    auto exec_ctx = db.GetExecutionContext(txn);
+    std::vector<Tuple> fact_tuples;
+    for (data_t key = 0; key < 10000; key++) {
+        fact_tuples.push_back(Tuple{key, key % 1000});
+    }
+    std::vector<Tuple> dimension_tuples;
+    for (data_t id = 0; id < 1000; id += 100) {
+        dimension_tuples.push_back(Tuple{id, id + 1});
+    }
+    // Counts the fact rows getting past the scan.
+    std::atomic<idx_t> scanned_rows{0};
+    auto fact = std::make_shared<FilterOperator>(exec_ctx,
+        std::make_shared<ValueOperator>(exec_ctx, Schema{"f.key", "f.dim"}, std::move(fact_tuples)),
+        std::make_unique<UDFilter>(Schema{"f.key"}, [&scanned_rows](Tuple &&) {
+            scanned_rows++;
+            return true;
+        }));
+    auto projection = std::make_shared<ProjectionOperator>(exec_ctx, fact, std::make_unique<UnitProjection>("f.dim"));
+    auto join = std::make_shared<HashJoinOperator>(exec_ctx, projection,
+        std::make_shared<ValueOperator>(exec_ctx, Schema{"d.id", "d.value"}, std::move(dimension_tuples)),
+        "f.dim", "d.id");
+    auto aggregate = AggregateOperator(exec_ctx, join, "d.id", "d.value");
+    std::vector<Tuple> expected;
+    for (data_t id = 0; id < 1000; id += 100) {
+        expected.push_back(Tuple{id, (id + 1) * 10});
+    }
+    EXPECT_EQ(RunOperator(aggregate), expected);
+    // 100 rows match, the false positives of the filter are about 1%.
+    EXPECT_GE(scanned_rows.load(), 100);
+    EXPECT_LT(scanned_rows.load(), 1000);
+
+    // Every id of the range is in the build, a filter would pass every fact row, so none is pushed.
+    std::vector<Tuple> dense_tuples;
+    for (data_t id = 0; id < 1000; id++) {
+        dense_tuples.push_back(Tuple{id, 1});
+    }
+    scanned_rows = 0;
+    auto dense_join = std::make_shared<HashJoinOperator>(exec_ctx, projection,
+        std::make_shared<ValueOperator>(exec_ctx, Schema{"d.id", "d.value"}, std::move(dense_tuples)),
+        "f.dim", "d.id");
+    auto dense_aggregate = AggregateOperator(exec_ctx, dense_join, "d.value", "d.value");
+    EXPECT_EQ(RunOperator(dense_aggregate), (std::vector<Tuple>{{1, 10000}}));
+    EXPECT_EQ(scanned_rows.load(), 10000);
+}
+
+TEST(ExecutionTest, GeneralAggregation) {
+    BabyDB db(ConfigGroup{.WORKER_THREADS = 4, .MORSEL_SIZE = 1000});
+    auto txn = db.CreateTxn();
+    auto exec_ctx = db.GetExecutionContext(txn);
+    Schema schema{"dense", "sparse", "small", "value"};
+    const data_t n = 20000;
+    std::vector<Tuple> tuples;
+    for (data_t key = 0; key < n; key++) {
+        tuples.push_back(Tuple{key % 100, (key % 37) << 40, key % 3, key * 7 % 1000});
+    }
+    std::vector<AggregateFunction> aggregates{{AggregateType::COUNT, INVALID_NAME}, {AggregateType::SUM, "value"},
+                                              {AggregateType::MIN, "value"}, {AggregateType::MAX, "value"},
+                                              {AggregateType::AVG, "value"}};
+    auto expect_groups = [&](const Schema &group_by) {
+        auto attrs = schema.GetKeyAttrs(group_by);
+        std::map<Tuple, std::vector<data_t>> groups;
+        for (auto &tuple : tuples) {
+            groups[tuple.KeysFromTuple(attrs)].push_back(tuple[3]);
+        }
+        std::vector<Tuple> expected;
+        for (auto &[keys, values] : groups) {
+            Tuple row = keys;
+            data_t sum = 0;
+            for (auto value : values) {
+                sum += value;
+            }
+            row.push_back(values.size());
+            row.push_back(sum);
+            row.push_back(*std::min_element(values.begin(), values.end()));
+            row.push_back(*std::max_element(values.begin(), values.end()));
+            row.push_back(sum / values.size());
+            expected.push_back(row);
+        }
+        return expected;
+    };
+
+    // A dense key takes the direct array, a sparse or a composite key the partitioned tables.
+    for (auto &group_by : {Schema{"dense"}, Schema{"sparse"}, Schema{"sparse", "small"}, Schema{"small", "dense"},
+                           Schema{}}) {
+        auto aggregate = AggregateOperator(exec_ctx,
+            std::make_shared<ValueOperator>(exec_ctx, schema, std::vector<Tuple>(tuples)), group_by, aggregates);
+        EXPECT_EQ(aggregate.GetOutputSchema().back(), "AVG(value)");
+        EXPECT_EQ(RunOperator(aggregate), expect_groups(group_by));
+    }
+
+    auto count = AggregateOperator(exec_ctx, std::make_shared<ValueOperator>(exec_ctx, schema, std::vector<Tuple>()),
+                                   Schema{"dense"}, aggregates);
+    EXPECT_EQ(RunOperator(count), std::vector<Tuple>());
+    // Without group by columns an empty input still aggregates to one row.
+    auto total = AggregateOperator(exec_ctx, std::make_shared<ValueOperator>(exec_ctx, schema, std::vector<Tuple>()),
+                                   Schema{}, aggregates);
+    EXPECT_EQ(RunOperator(total), (std::vector<Tuple>{{0, 0, 0, 0, 0}}));
+    auto invalid = AggregateOperator(exec_ctx, std::make_shared<ValueOperator>(exec_ctx, schema, std::vector<Tuple>()),
+                                     Schema{"dense"}, {{AggregateType::SUM, INVALID_NAME}});
+    EXPECT_THROW(invalid.Check(), std::logic_error);
+}
+
+TEST(ExecutionTest, SpillToDisk) {
+    auto run = [](idx_t memory_limit) {
+        BabyDB db(ConfigGroup{.WORKER_THREADS = 2, .MORSEL_SIZE = 1000, .QUERY_MEMORY_LIMIT = memory_limit});
+        auto txn = db.CreateTxn();
+        auto exec_ctx = db.GetExecutionContext(txn);
+        const data_t n = 20000;
+        std::vector<Tuple> probe_tuples;
+        std::vector<Tuple> build_tuples;
+        for (data_t key = 0; key < n; key++) {
+            probe_tuples.push_back(Tuple{key % 5000, key});
+            // Key 0 is a run of duplicates, which no split of the partition makes smaller.
+            build_tuples.push_back(Tuple{key % 3 == 0 ? 0 : key, key << 20});
+        }
+        auto join = [&]() {
+            auto probe = std::make_shared<ValueOperator>(exec_ctx, Schema{"a.key", "a.payload"},
+                                                         std::vector<Tuple>(probe_tuples));
+            auto build = std::make_shared<ValueOperator>(exec_ctx, Schema{"b.key", "b.group"},
+                                                         std::vector<Tuple>(build_tuples));
+            return std::make_shared<HashJoinOperator>(exec_ctx, probe, build, "a.key", "b.key");
+        };
+        // The join alone is pulled, under the aggregate it runs as a pipeline.
+        auto pulled_join = join();
+        auto join_results = RunOperator(*pulled_join);
+        auto aggregate = AggregateOperator(exec_ctx, join(), Schema{"b.group"},
+                                           {{AggregateType::COUNT, INVALID_NAME}, {AggregateType::SUM, "a.payload"}});
+        auto aggregate_results = RunOperator(aggregate);
+        return std::make_tuple(join_results, aggregate_results, pulled_join->SpilledPartitionCount(),
+                               aggregate.SpilledPartitionCount());
+    };
+    auto [join_results, aggregate_results, join_spills, aggregate_spills] = run(0);
+    // 4 probe rows of key 0 meet 6667 build rows, 4 probe rows of each other key meet at most one.
+    EXPECT_EQ(join_results.size(), 4 * 6667 + 4 * 3333);
+    EXPECT_EQ(join_spills, 0);
+    EXPECT_EQ(aggregate_spills, 0);
+    auto [spilled_join_results, spilled_aggregate_results, spilled_join_spills, spilled_aggregate_spills] =
+        run(128 * 1024);
+    EXPECT_GT(spilled_join_spills, 0);
+    EXPECT_GT(spilled_aggregate_spills, 0);
+    EXPECT_EQ(spilled_join_results, join_results);
+    EXPECT_EQ(spilled_aggregate_results, aggregate_results);
+}
+
+TEST(ExecutionTest, SortAndTopK) {
+    auto run = [](idx_t memory_limit, idx_t worker_threads) {
+        BabyDB db(ConfigGroup{.WORKER_THREADS = worker_threads, .MORSEL_SIZE = 1000,
+                              .QUERY_MEMORY_LIMIT = memory_limit});
+        auto txn = db.CreateTxn();
+        auto exec_ctx = db.GetExecutionContext(txn);
+        Schema schema{"a", "b", "payload"};
+        std::vector<Tuple> tuples;
+        const data_t n = 30000;
+        for (data_t key = 0; key < n; key++) {
+            tuples.push_back(Tuple{key * 7919 % 100, (key * 104729 % n) << 24, key});
+        }
+        std::vector<SortKey> sort_keys{{"a", false}, {"b", true}};
+        auto values = std::make_shared<ValueOperator>(exec_ctx, schema, std::vector<Tuple>(tuples));
+        auto sort = SortOperator(exec_ctx, values, sort_keys);
+        auto sorted = RunOperator(sort, false);
+
+        auto expected = tuples;
+        std::sort(expected.begin(), expected.end(), [](const Tuple &left, const Tuple &right) {
+            return left[0] != right[0] ? left[0] < right[0] : left[1] > right[1];
+        });
+        EXPECT_EQ(sorted, expected);
+
+        auto top_k = TopKOperator(exec_ctx, values, sort_keys, 100);
+        EXPECT_EQ(RunOperator(top_k, false), std::vector<Tuple>(expected.begin(), expected.begin() + 100));
+        auto top_all = TopKOperator(exec_ctx, values, sort_keys, n * 2);
+        EXPECT_EQ(RunOperator(top_all, false), expected);
+        auto top_none = TopKOperator(exec_ctx, values, sort_keys, 0);
+        EXPECT_EQ(RunOperator(top_none, false), std::vector<Tuple>());
+    };
+    run(0, 0);
+    run(0, 4);
+    // Runs of about 1000 rows, merged in several passes of two runs each.
+    run(64 * 1024, 2);
+}
+
+TEST(ExecutionTest, MergeJoin) {
+    BabyDB db(ConfigGroup{.CHUNK_SUGGEST_SIZE = 7});
+    Schema a_schema{"a.key", "a.payload"};
+    Schema b_schema{"b.key", "b.payload"};
+    db.CreateTable("a", a_schema);
+    db.CreateTable("b", b_schema);
+    db.CreateIndex("a_i", "a", "a.key", IndexType::ART);
+    db.CreateIndex("b_i", "b", "b.key", IndexType::ART);
+    std::vector<Tuple> a_tuples;
+    std::vector<Tuple> b_tuples;
+    for (data_t key = 0; key < 3000; key++) {
+        a_tuples.push_back(Tuple{key * 2, key});
+        b_tuples.push_back(Tuple{key * 3, key});
+    }
+    auto txn = db.CreateTxn();
+    auto load_ctx = db.GetExecutionContext(txn);
+    auto insert_a = InsertOperator(load_ctx, std::make_shared<ValueOperator>(load_ctx, a_schema, std::move(a_tuples)),
+                                   "a");
+    RunOperator(insert_a);
+    auto insert_b = InsertOperator(load_ctx, std::make_shared<ValueOperator>(load_ctx, b_schema, std::move(b_tuples)),
+                                   "b");
+    RunOperator(insert_b);
+    EXPECT_EQ(db.Commit(*txn), true);
+
+    txn = db.CreateTxn();
+    auto exec_ctx = db.GetExecutionContext(txn);
+    auto scan = [&exec_ctx](const std::string &table, const Schema &schema) {
+        return std::make_shared<RangeIndexScanOperator>(exec_ctx, table, schema, schema, table + "_i",
+                                                        RangeInfo{DATA_MIN, DATA_MAX});
+    };
+    auto hash_join = HashJoinOperator(exec_ctx, scan("a", a_schema), scan("b", b_schema), "a.key", "b.key");
+    auto expected = RunOperator(hash_join);
+    EXPECT_EQ(expected.size(), 1000);
+    // Two index scans come in key order, and so does the output.
+    auto merge_join = MergeJoinOperator(exec_ctx, scan("a", a_schema), scan("b", b_schema), "a.key", "b.key");
+    EXPECT_EQ(RunOperator(merge_join, false), expected);
+
+    // Runs of duplicate keys on both sides.
+    std::vector<Tuple> left_tuples;
+    std::vector<Tuple> right_tuples;
+    for (data_t i = 0; i < 500; i++) {
+        left_tuples.push_back(Tuple{i % 37, i});
+        right_tuples.push_back(Tuple{i % 23 * 2, i});
+    }
+    auto sorted = [&exec_ctx](const std::string &prefix, std::vector<Tuple> tuples) {
+        auto values = std::make_shared<ValueOperator>(exec_ctx, Schema{prefix + ".key", prefix + ".payload"},
+                                                      std::move(tuples));
+        return std::make_shared<SortOperator>(exec_ctx, values, std::vector<SortKey>{{prefix + ".key"}});
+    };
+    auto hash_join_duplicates = HashJoinOperator(exec_ctx, sorted("l", left_tuples), sorted("r", right_tuples),
+                                                 "l.key", "r.key");
+    auto merge_join_duplicates = MergeJoinOperator(exec_ctx, sorted("l", left_tuples), sorted("r", right_tuples),
+                                                   "l.key", "r.key");
+    EXPECT_EQ(RunOperator(merge_join_duplicates), RunOperator(hash_join_duplicates));
+
+    auto unsorted = MergeJoinOperator(exec_ctx,
+        std::make_shared<ValueOperator>(exec_ctx, Schema{"l.key"}, std::vector<Tuple>{{2}, {1}}),
+        std::make_shared<ValueOperator>(exec_ctx, Schema{"r.key"}, std::vector<Tuple>{{1}, {2}}), "l.key", "r.key");
+    EXPECT_THROW(RunOperator(unsorted), std::logic_error);
+}
+
+}
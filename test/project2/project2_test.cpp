@@ -22,12 +22,12 @@ static std::vector<Tuple> RunOperator(Operator &test_operator, bool sort_output
     test_operator.Check();
     test_operator.Init();
     std::vector<Tuple> results;
-    Chunk chunk;
+    DataChunk chunk;
     auto operator_state = OperatorState::HAVE_MORE_OUTPUT;
     while (operator_state != EXHAUSETED) {
         operator_state = test_operator.Next(chunk);
-        for (auto &row : chunk) {
-            results.push_back(row.first);
+        for (idx_t position = 0; position < chunk.Size(); position++) {
+            results.push_back(chunk.GetTuple(position));
         }
     }
     if (sort_output) {
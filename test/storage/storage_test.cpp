@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+
+#include "babydb.hpp"
+#include "execution/insert_operator.hpp"
+#include "execution/value_operator.hpp"
+#include "execution/update_operator.hpp"
+#include "execution/range_index_scan_operator.hpp"
+#include "execution/projection_operator.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace babydb {
+
+static std::vector<Tuple> RunOperator(Operator &test_operator) {
+    test_operator.Check();
+    test_operator.Init();
+    std::vector<Tuple> results;
+    DataChunk chunk;
+    auto operator_state = OperatorState::HAVE_MORE_OUTPUT;
+    while (operator_state != EXHAUSETED) {
+        operator_state = test_operator.Next(chunk);
+        for (idx_t position = 0; position < chunk.Size(); position++) {
+            results.push_back(chunk.GetTuple(position));
+        }
+    }
+    return results;
+}
+
+TEST(StorageTest, ParallelScanAndIndexBuild) {
+    BabyDB db(ConfigGroup{.WORKER_THREADS = 4});
+    Schema schema{"key", "payload"};
+    db.CreateTable("t0", schema);
+    db.CreateIndex("t0_i0", "t0", "key", IndexType::ART);
+
+    const idx_t n = 20000;
+    std::mt19937_64 rnd(42);
+    std::vector<Tuple> tuples;
+    for (idx_t i = 0; i < n; i++) {
+        // Mix dense small keys with sparse large ones, so the tree has both wide and deep subtrees.
+        data_t key = i % 2 == 0 ? i : (rnd() >> 1);
+        tuples.push_back(Tuple{key, i});
+    }
+    std::sort(tuples.begin(), tuples.end());
+    tuples.erase(std::unique(tuples.begin(), tuples.end(),
+                             [](const Tuple &a, const Tuple &b) { return a[0] == b[0]; }), tuples.end());
+    auto expected = tuples;
+    std::shuffle(tuples.begin(), tuples.end(), rnd);
+
+    auto txn = db.CreateTxn();
+    auto insert_operator = InsertOperator(db.GetExecutionContext(txn),
+        std::make_shared<ValueOperator>(db.GetExecutionContext(txn), schema, std::move(tuples)), "t0");
+    RunOperator(insert_operator);
+    EXPECT_EQ(db.Commit(*txn), true);
+
+    txn = db.CreateTxn();
+    auto full_scan = RangeIndexScanOperator(db.GetExecutionContext(txn), "t0", schema, schema, "t0_i0",
+                                            RangeInfo{DATA_MIN, DATA_MAX});
+    EXPECT_EQ(RunOperator(full_scan), expected);
+    auto half_open_scan = RangeIndexScanOperator(db.GetExecutionContext(txn), "t0", schema, schema, "t0_i0",
+                                                 RangeInfo{100, 5000, false, false});
+    std::vector<Tuple> expected_range;
+    for (auto &tuple : expected) {
+        if (tuple[0] > 100 && tuple[0] < 5000) {
+            expected_range.push_back(tuple);
+        }
+    }
+    EXPECT_EQ(RunOperator(half_open_scan), expected_range);
+
+    auto update_operator = UpdateOperator(db.GetExecutionContext(txn),
+        std::make_shared<ProjectionOperator>(db.GetExecutionContext(txn),
+            std::make_shared<RangeIndexScanOperator>(db.GetExecutionContext(txn), "t0", schema, schema, "t0_i0",
+                                                     RangeInfo{0, 1000}),
+            std::make_unique<UDProjection>("payload", [](Tuple &&a) { return a[0] + 1; })));
+    RunOperator(update_operator);
+    EXPECT_EQ(db.Commit(*txn), true);
+    for (auto &tuple : expected) {
+        if (tuple[0] <= 1000) {
+            tuple[1]++;
+        }
+    }
+
+    // Rebuilding the index on the populated table picks the latest row of every key.
+    db.DropIndex("t0_i0");
+    db.CreateIndex("t0_i1", "t0", "key", IndexType::ART);
+    txn = db.CreateTxn();
+    auto rebuilt_scan = RangeIndexScanOperator(db.GetExecutionContext(txn), "t0", schema, schema, "t0_i1",
+                                               RangeInfo{DATA_MIN, DATA_MAX});
+    EXPECT_EQ(RunOperator(rebuilt_scan), expected);
+    EXPECT_EQ(db.Commit(*txn), true);
+}
+
+}